@@ -0,0 +1,76 @@
+// Conteo opcional de reservas de memoria dinámica.
+// Al compilar con -DTETRIS_CONTAR_ASIGNACIONES se reemplaza el operador new global
+// para contar cada reserva; sin la opción allocationCount() siempre retorna 0 y no
+// hay ningún costo. Reemplaza operadores globales: incluir en un solo archivo .cpp.
+#ifndef TETRIS_ALLOC_H
+#define TETRIS_ALLOC_H
+
+#include <cstdint>      // Tipos enteros de tamaño fijo
+#include <algorithm>    // max()
+
+#ifdef TETRIS_CONTAR_ASIGNACIONES
+#include <atomic>       // Contador compartido entre hilos
+#include <cstdlib>      // malloc() y free()
+#include <new>          // bad_alloc, align_val_t
+
+inline std::atomic<uint64_t> allocationsTotal{0};
+
+void *operator new(std::size_t size) {
+   allocationsTotal.fetch_add(1, std::memory_order_relaxed);
+   if (void *p = std::malloc(size ? size : 1)) {
+      return p;
+   }
+   throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, std::align_val_t align) {
+   allocationsTotal.fetch_add(1, std::memory_order_relaxed);
+   std::size_t alignment = static_cast<std::size_t>(align);
+#ifdef _WIN32
+   void *p = _aligned_malloc(size ? size : 1, alignment);
+#else
+   void *p = std::aligned_alloc(alignment, (std::max<std::size_t>(size, 1) + alignment - 1) / alignment * alignment);
+#endif
+   if (p) {
+      return p;
+   }
+   throw std::bad_alloc();
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"   // new y delete se reemplazan en pareja sobre malloc()/free()
+#endif
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+void operator delete(void *p, std::align_val_t) noexcept {
+#ifdef _WIN32
+   _aligned_free(p);
+#else
+   std::free(p);
+#endif
+}
+
+const bool ALLOCATION_COUNTING = true;
+inline uint64_t allocationCount() { return allocationsTotal.load(std::memory_order_relaxed); }
+#else
+const bool ALLOCATION_COUNTING = false;
+inline uint64_t allocationCount() { return 0; }
+#endif
+
+// Reservas por cuadro del bucle del juego
+struct AllocationStats {
+   uint64_t frames = 0;                  // Cuadros medidos
+   uint64_t framesWithAllocations = 0;   // Cuadros que reservaron memoria
+   uint64_t maxPerFrame = 0;             // Peor cuadro
+   uint64_t total = 0;                   // Reservas en toda la partida (sin contar la preparación)
+
+   void frame(uint64_t count) {
+      frames++;
+      framesWithAllocations += count ? 1 : 0;
+      maxPerFrame = std::max(maxPerFrame, count);
+      total += count;
+   }
+};
+
+#endif
@@ -0,0 +1,218 @@
+// Banco de pruebas sin interfaz del motor del juego.
+// Mide las operaciones del núcleo sobre conjuntos fijos de tableros generados con
+// semilla (vacío, medio juego y a punto de perder), así los números de dos commits
+// se refieren exactamente a las mismas entradas. Informa ns/op y reservas/op por
+// operación y conjunto, y escribe un resumen JSON (una medida por línea) para
+// compararlo con diff entre commits.
+//
+// tetrisBench [--rounds N] [--json archivo]
+#ifndef TETRIS_CONTAR_ASIGNACIONES
+#define TETRIS_CONTAR_ASIGNACIONES   // El banco siempre cuenta las reservas
+#endif
+
+#include <iostream>     // Informe en consola
+#include <fstream>      // Resumen JSON
+#include <vector>       // Conjuntos de tableros y resultados
+#include <string>       // Opciones de línea de comandos
+#include <random>       // Generación de los tableros
+#include <chrono>       // Medición de tiempos
+#include <algorithm>    // min()
+
+#ifndef _WIN32
+#include <fcntl.h>      // open() de /dev/null
+#include <unistd.h>     // close()
+#endif
+
+#include "tetrisCore.h"  // Tablero, piezas y estado de la partida
+#include "tetrisMoves.h" // Colocaciones alcanzables para construir los tableros
+#include "tetrisBot.h"   // Evaluación del tablero
+#include "tetrisRender.h" // Renderizador de terminal
+#include "tetrisAlloc.h" // Conteo de reservas de memoria
+
+using namespace std;
+
+const int TABLEROS_POR_CONJUNTO = 64;   // Tableros distintos de cada conjunto
+const int OPERACIONES = 1 << 18;        // Operaciones por ronda (las del renderizado se dividen por RENDER_DIVISOR)
+const int RENDER_DIVISOR = 64;          // Un cuadro completo cuesta varios órdenes de magnitud más que una colocación
+
+// Conjunto de tableros con una pieza recién aparecida y una colocación alcanzable para cada uno
+struct Corpus {
+   const char *name;
+   vector<Board> boards;
+   vector<Piece> spawned;     // Pieza en su posición de aparición
+   vector<Piece> landed;      // La misma pieza en una colocación alcanzable (ya no puede bajar)
+};
+
+// Resultado de una operación sobre un conjunto
+struct BenchResult {
+   string name, corpus;
+   double nsPerOp = 0;
+   double allocationsPerOp = 0;
+};
+
+// Juega partidas con la evaluación del bot y colocaciones al azar (para que queden huecos)
+// y guarda el tablero cada vez que su altura máxima cae en [minHeight, maxHeight]
+Corpus buildCorpus(const char *name, int minHeight, int maxHeight, uint64_t seed) {
+   Corpus corpus{name, {}, {}, {}};
+   mt19937_64 rng(seed);
+   MoveGenerator generator;
+   vector<Placement> placements;
+   EvalWeights weights;
+   GameState game(rng());
+   while ((int)corpus.boards.size() < TABLEROS_POR_CONJUNTO) {
+      generator.generate(game.board, game.activePiece.type, placements);
+      int height = game.board.maxHeight();
+      if (height >= minHeight && height <= maxHeight && !placements.empty()) {
+         corpus.boards.push_back(game.board);
+         corpus.spawned.push_back(game.activePiece);
+         corpus.landed.push_back(placements[rng() % placements.size()].piece);
+      }
+      if (placements.empty() || height > maxHeight) {
+         game.reset(rng());                      // Se pasó de la altura buscada o perdió: partida nueva
+         continue;
+      }
+      size_t chosen = rng() % placements.size();
+      if (rng() % 4 != 0) {                      // Tres de cada cuatro piezas las coloca la evaluación
+         double bestScore = -1e18;
+         for (size_t k = 0; k < placements.size(); ++k) {
+            Board next = game.board;
+            next.placePiece(placements[k].piece);
+            double score = evaluateBoard(next, next.clearFullLines(), weights);
+            if (score > bestScore) {
+               bestScore = score;
+               chosen = k;
+            }
+         }
+      }
+      game.activePiece = placements[chosen].piece;
+      game.lockPiece();
+      if (game.gameOver) {
+         game.reset(rng());
+      }
+   }
+   return corpus;
+}
+
+// Ejecuta 'body' sobre los índices [0, ops) en varias rondas y se queda con la más rápida;
+// las reservas se promedian sobre todas las rondas
+template <typename Body>
+BenchResult measure(const char *name, const char *corpus, int rounds, int ops, Body body) {
+   volatile uint64_t sink = 0;                   // Impide que el compilador descarte el trabajo
+   uint64_t warmup = 0;
+   for (int i = 0; i < ops; ++i) {
+      warmup += body(i);
+   }
+   sink = sink + warmup;
+   double best = 1e300;
+   uint64_t allocated = allocationCount();
+   for (int r = 0; r < rounds; ++r) {
+      uint64_t acc = 0;
+      auto start = chrono::steady_clock::now();
+      for (int i = 0; i < ops; ++i) {
+         acc += body(i);
+      }
+      double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+      best = min(best, ns / ops);
+      sink = sink + acc;
+   }
+   allocated = allocationCount() - allocated;
+   BenchResult result;
+   result.name = name;
+   result.corpus = corpus;
+   result.nsPerOp = best;
+   result.allocationsPerOp = double(allocated) / (double(rounds) * ops);
+   return result;
+}
+
+bool writeJson(const char *path, const vector<BenchResult> &results) {   // Una medida por línea para que el diff sea legible
+   ofstream out(path);
+   out << "{\"benchmarks\": [\n";
+   for (size_t k = 0; k < results.size(); ++k) {
+      const BenchResult &r = results[k];
+      out << "  {\"name\": \"" << r.name << "\", \"corpus\": \"" << r.corpus << "\", \"ns_per_op\": " << r.nsPerOp
+          << ", \"allocs_per_op\": " << r.allocationsPerOp << "}" << (k + 1 < results.size() ? "," : "") << "\n";
+   }
+   out << "]}\n";
+   return bool(out);
+}
+
+int main(int argc, char *argv[]) {
+   int rounds = 5;
+   string jsonPath = "tetrisBench.json";
+   for (int i = 1; i < argc; ++i) {
+      string arg = argv[i];
+      if (arg == "--rounds" && i + 1 < argc) {
+         rounds = max(1, stoi(argv[++i]));
+      } else if (arg == "--json" && i + 1 < argc) {
+         jsonPath = argv[++i];
+      } else {
+         cerr << "Opción desconocida: " << arg << "\n";
+         return 1;
+      }
+   }
+
+   vector<Corpus> corpora;
+   corpora.push_back(buildCorpus("vacio", 0, 0, 11));
+   corpora.push_back(buildCorpus("medio", 7, 10, 12));
+   corpora.push_back(buildCorpus("tope", 15, HEIGHT - 2, 13));
+
+   vector<BenchResult> results;
+   const int mask = TABLEROS_POR_CONJUNTO - 1;
+   for (const Corpus &c : corpora) {
+      results.push_back(measure("canPlacePiece", c.name, rounds, OPERACIONES, [&](int i) -> uint64_t {
+         int k = (i >> 1) & mask;                // Alterna entre bajar la pieza apoyada y mover la recién aparecida
+         return i & 1 ? c.boards[k].canPlacePiece(c.spawned[k], (i >> 2) & 1 ? 1 : -1, 0) : c.boards[k].canPlacePiece(c.landed[k], 0, 1);
+      }));
+      results.push_back(measure("placePiece", c.name, rounds, OPERACIONES, [&](int i) -> uint64_t {
+         Board board = c.boards[i & mask];       // Incluye copiar el tablero
+         board.placePiece(c.landed[i & mask]);
+         return board.hash;
+      }));
+      results.push_back(measure("placePiece+clearFullLines", c.name, rounds, OPERACIONES, [&](int i) -> uint64_t {
+         Board board = c.boards[i & mask];
+         board.placePiece(c.landed[i & mask]);
+         return board.clearFullLines() + board.hash;
+      }));
+      results.push_back(measure("rotatePiece", c.name, rounds, OPERACIONES, [&](int i) -> uint64_t {
+         Piece piece = c.landed[i & mask];       // Junto al montón, donde las patadas SRS trabajan más
+         return c.boards[i & mask].rotatePiece(piece) + piece.x;
+      }));
+   }
+
+   GameState generatorGame(1);
+   results.push_back(measure("createRandomPiece", "-", rounds, OPERACIONES, [&](int) -> uint64_t {
+      return generatorGame.createRandomPiece().type;
+   }));
+
+#ifndef _WIN32   // En Windows el renderizador escribe siempre en la consola
+   int sink = open("/dev/null", O_WRONLY);
+   TerminalRenderer renderer(sink);              // Cuadros que no se muestran
+   for (const Corpus &c : corpora) {
+      vector<GameState> games(TABLEROS_POR_CONJUNTO, GameState(1, MAX_PIEZAS_PREVIAS));
+      for (int k = 0; k < TABLEROS_POR_CONJUNTO; ++k) {
+         games[k].board = c.boards[k];
+         games[k].activePiece = c.spawned[k];
+      }
+      results.push_back(measure("renderGame", c.name, rounds, OPERACIONES / RENDER_DIVISOR, [&](int i) -> uint64_t {
+         renderer.invalidate();                  // Cuadro completo, sin aprovechar el anterior
+         renderer.render(games[i & mask]);
+         return renderer.stats.bytes;
+      }));
+   }
+   close(sink);
+#endif
+
+   cout << "Operación                    Conjunto      ns/op    reservas/op\n";
+   for (const BenchResult &r : results) {
+      string name = r.name + string(max<int>(1, 29 - r.name.size()), ' ');
+      cout << name << r.corpus << string(max<int>(1, 10 - int(r.corpus.size())), ' ');
+      cout.width(10);
+      cout << r.nsPerOp << "    " << r.allocationsPerOp << "\n";
+   }
+   if (!writeJson(jsonPath.c_str(), results)) {
+      cerr << "No se pudo escribir " << jsonPath << "\n";
+      return 1;
+   }
+   cout << "Resumen en " << jsonPath << "\n";
+   return 0;
+}
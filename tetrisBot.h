@@ -0,0 +1,348 @@
+// Jugador automático: evaluación del tablero, búsqueda en haz y un pool de hilos
+// con robo de tareas para expandir cada nivel del haz en paralelo.
+#ifndef TETRIS_BOT_H
+#define TETRIS_BOT_H
+
+#include <vector>              // Niveles del haz
+#include <deque>               // Colas de tareas de cada hilo
+#include <memory>              // Colas de tareas en memoria estable
+#include <functional>          // Tareas genéricas del pool
+#include <thread>              // Hilos trabajadores
+#include <mutex>               // Protección de las colas
+#include <condition_variable>  // Espera de los hilos sin tareas
+#include <atomic>              // Contadores compartidos
+#include <algorithm>           // partial_sort(), max()
+#include <chrono>              // Latencia de cada decisión
+
+#include "tetrisCore.h"  // Tablero y piezas
+#include "tetrisMoves.h" // Generador de colocaciones
+#include "tetrisHash.h"  // Tabla de transposición
+
+// Pool de hilos con una cola por hilo: cada hilo toma sus tareas del final de su cola
+// y, cuando se queda sin trabajo, roba del principio de las colas de los demás
+class ThreadPool {
+public:
+   explicit ThreadPool(unsigned threads = std::thread::hardware_concurrency()) {
+      threads = std::max(1u, threads);
+      for (unsigned i = 0; i < threads; ++i) {
+         queues.emplace_back(new TaskQueue());
+      }
+      for (unsigned i = 1; i < threads; ++i) {   // La cola 0 pertenece al hilo que llama a parallelFor()
+         workers.emplace_back([this, i] { workerLoop(i); });
+      }
+   }
+
+   ~ThreadPool() {
+      {
+         std::lock_guard<std::mutex> lock(sleepMutex);
+         stopping = true;
+      }
+      wakeUp.notify_all();
+      for (std::thread &worker : workers) {
+         worker.join();
+      }
+   }
+
+   unsigned size() const { return queues.size(); }   // Hilos que ejecutan tareas (incluye al que llama)
+
+   // Ejecuta body(i) para cada i en [0, count) y espera a que terminen todas; el hilo que llama también trabaja
+   template <typename Body>
+   void parallelFor(int count, const Body &body) {
+      if (count <= 0) {
+         return;
+      }
+      int chunks = std::min<int>(count, size() * 4);    // Varias porciones por hilo para que el robo equilibre la carga
+      int remaining = chunks;                            // Protegido por doneMutex
+      std::mutex doneMutex;
+      std::condition_variable done;
+      for (int c = 0; c < chunks; ++c) {
+         int begin = count * c / chunks, end = count * (c + 1) / chunks;
+         submit(c % size(), [&body, &remaining, &doneMutex, &done, begin, end] {
+            for (int i = begin; i < end; ++i) {
+               body(i);
+            }
+            std::lock_guard<std::mutex> lock(doneMutex);   // Bajo el cerrojo: el que llama no sale antes de que termine el aviso
+            if (--remaining == 0) {
+               done.notify_one();
+            }
+         });
+      }
+      while (runOne(0)) {
+      }
+      std::unique_lock<std::mutex> lock(doneMutex);      // Las tareas restantes ya están en ejecución en otros hilos
+      done.wait(lock, [&remaining] { return remaining == 0; });
+   }
+
+private:
+   struct TaskQueue {
+      std::mutex mutex;
+      std::deque<std::function<void()>> tasks;
+   };
+
+   std::vector<std::unique_ptr<TaskQueue>> queues;
+   std::vector<std::thread> workers;
+   std::mutex sleepMutex;
+   std::condition_variable wakeUp;
+   std::atomic<int> pending{0};     // Tareas encoladas que nadie ha tomado todavía
+   bool stopping = false;
+
+   void submit(unsigned queue, std::function<void()> task) {
+      {
+         std::lock_guard<std::mutex> lock(queues[queue]->mutex);
+         queues[queue]->tasks.push_back(std::move(task));
+      }
+      {
+         std::lock_guard<std::mutex> lock(sleepMutex);
+         pending++;
+      }
+      wakeUp.notify_one();
+   }
+
+   bool runOne(unsigned self) {   // Ejecuta una tarea propia o robada; falso si no había ninguna
+      std::function<void()> task;
+      for (unsigned k = 0; k < size() && !task; ++k) {
+         TaskQueue &queue = *queues[(self + k) % size()];
+         std::lock_guard<std::mutex> lock(queue.mutex);
+         if (queue.tasks.empty()) {
+            continue;
+         }
+         if (k == 0) {
+            task = std::move(queue.tasks.back());     // Tarea propia: la más reciente
+            queue.tasks.pop_back();
+         } else {
+            task = std::move(queue.tasks.front());    // Robo: la más antigua de otro hilo
+            queue.tasks.pop_front();
+         }
+      }
+      if (!task) {
+         return false;
+      }
+      pending--;
+      task();
+      return true;
+   }
+
+   void workerLoop(unsigned self) {
+      while (true) {
+         if (runOne(self)) {
+            continue;
+         }
+         std::unique_lock<std::mutex> lock(sleepMutex);
+         wakeUp.wait(lock, [this] { return stopping || pending > 0; });
+         if (stopping) {
+            return;
+         }
+      }
+   }
+};
+
+// Pesos de la función de evaluación del tablero
+struct EvalWeights {
+   double height = -0.510066;       // Altura agregada de las columnas
+   double lines = 0.760666;         // Líneas eliminadas
+   double holes = -0.35663;         // Celdas vacías con algún bloque encima
+   double bumpiness = -0.184483;    // Diferencia de altura entre columnas vecinas
+   double wells = 0;                // Profundidad de los pozos (0 = no se usa; lo ajusta el entrenador)
+};
+
+// Características del tablero usadas por la evaluación
+struct BoardFeatures {
+   int aggregateHeight = 0, holes = 0, bumpiness = 0, wells = 0;
+};
+
+template <typename G>
+BoardFeatures computeFeatures(const BasicBoard<G> &board) {   // Lee las métricas que el tablero mantiene al colocar y limpiar
+   BoardFeatures features;
+   features.aggregateHeight = board.aggregateHeight;
+   features.holes = board.holes();
+   features.bumpiness = board.bumpiness;
+   features.wells = board.wells();
+   return features;
+}
+
+template <typename G>
+BoardFeatures scanFeatures(const BasicBoard<G> &board) {   // Recalcula altura agregada, huecos, rugosidad y pozos recorriendo todo el tablero
+   BoardFeatures features;
+   int previousHeight = -1;
+   int heights[G::WIDTH + 2];
+   heights[0] = heights[G::WIDTH + 1] = G::HEIGHT;     // Paredes
+   for (int x = 0; x < G::WIDTH; ++x) {
+      int top = 0;
+      while (top < G::HEIGHT && !board.cell(x, top)) {
+         ++top;
+      }
+      int height = G::HEIGHT - top;
+      for (int y = top + 1; y < G::HEIGHT; ++y) {
+         features.holes += board.cell(x, y) ? 0 : 1;
+      }
+      features.aggregateHeight += height;
+      features.bumpiness += previousHeight < 0 ? 0 : std::abs(height - previousHeight);
+      previousHeight = height;
+      heights[x + 1] = height;
+   }
+   for (int x = 1; x <= G::WIDTH; ++x) {
+      features.wells += std::max(0, std::min(heights[x - 1], heights[x + 1]) - heights[x]);
+   }
+   return features;
+}
+
+template <typename G>
+double evaluateBoard(const BasicBoard<G> &board, int lines, const EvalWeights &weights) {   // Puntúa un tablero (más alto es mejor)
+   BoardFeatures features = computeFeatures(board);
+   return weights.height * features.aggregateHeight + weights.lines * lines
+        + weights.holes * features.holes + weights.bumpiness * features.bumpiness + weights.wells * features.wells;
+}
+
+// Configuración del jugador automático
+struct BotConfig {
+   int beamWidth = 64;        // Nodos que sobreviven en cada nivel del haz
+   int depth = 2;             // Piezas conocidas que se exploran (activa + vista previa)
+   EvalWeights weights;
+};
+
+// Estadísticas acumuladas de las decisiones tomadas
+struct BotStats {
+   uint64_t decisions = 0;    // Piezas decididas
+   uint64_t nodes = 0;        // Tableros evaluados
+   uint64_t cachedDecisions = 0;   // Decisiones resueltas directamente desde la tabla de transposición
+   double totalMs = 0;        // Tiempo total de decisión
+   double maxMs = 0;          // Peor latencia por pieza
+
+   double nodesPerSecond() const { return totalMs > 0 ? nodes / (totalMs / 1000) : 0; }
+   double averageMs() const { return decisions ? totalMs / decisions : 0; }
+};
+
+template <typename G>
+class BasicBeamSearchBot {
+public:
+   using Board = BasicBoard<G>;
+   using MoveGenerator = BasicMoveGenerator<G>;
+
+   BasicBeamSearchBot(ThreadPool &pool, const BotConfig &config, TranspositionTable *table = nullptr) : pool(pool), config(config), table(table) {}
+
+   // Elige la colocación de pieces[0] mirando hasta config.depth piezas; retorna el camino de acciones desde la aparición
+   bool choose(const Board &board, const Tetromino *pieces, int count, std::vector<Action> &path) {
+      auto start = std::chrono::steady_clock::now();
+      std::atomic<uint64_t> evaluated(0);
+      std::vector<Placement> roots;
+      rootGenerator.generate(board, pieces[0], roots);
+      if (roots.empty()) {
+         return false;
+      }
+      int depth = std::min(config.depth, count);
+      uint64_t key = positionHash(board, pieces, depth);
+      TTData cached;
+      if (table && table->probe(key, cached) && cached.hasMove && cached.depth >= depth) {
+         for (const Placement &root : roots) {   // La posición ya se resolvió por otro orden de jugadas
+            if (root.piece.rotation == cached.move.rotation && root.piece.x == cached.move.x && root.piece.y == cached.move.y) {
+               path = rootGenerator.pathTo(root);
+               stats.cachedDecisions++;
+               recordDecision(start, 0);
+               return true;
+            }
+         }
+      }
+      beam.clear();
+      for (int i = 0; i < (int)roots.size(); ++i) {
+         Node node{board, i, 0, 0};
+         node.board.placePiece(roots[i].piece);
+         node.lines = node.board.clearFullLines();
+         node.score = evaluate(node.board, node.lines);
+         beam.push_back(node);
+      }
+      evaluated += roots.size();
+      keepBest(beam);
+
+      for (int level = 1; level < depth; ++level) {   // Expande cada nivel del haz en paralelo
+         children.resize(beam.size());
+         Tetromino type = pieces[level];
+         pool.parallelFor(beam.size(), [&](int i) {
+            thread_local MoveGenerator generator;
+            thread_local std::vector<Placement> placements;
+            generator.generate(beam[i].board, type, placements);
+            children[i].clear();
+            for (const Placement &placement : placements) {
+               Node child = beam[i];
+               child.board.placePiece(placement.piece);
+               int cleared = child.board.clearFullLines();
+               child.lines += cleared;
+               child.score = evaluate(child.board, child.lines);
+               children[i].push_back(child);
+            }
+            evaluated += placements.size();
+         });
+         std::vector<Node> next;
+         for (std::vector<Node> &list : children) {
+            next.insert(next.end(), list.begin(), list.end());
+         }
+         if (next.empty()) {
+            break;     // Ninguna continuación posible: se decide con el nivel anterior
+         }
+         beam.swap(next);
+         keepBest(beam);
+      }
+
+      const Placement &best = roots[beam.front().root];
+      path = rootGenerator.pathTo(best);
+      if (table) {
+         TTData entry;
+         entry.score = float(beam.front().score);
+         entry.depth = int8_t(depth);
+         entry.hasMove = true;
+         entry.move = best.piece;
+         table->store(key, entry);     // Mejor jugada para esta posición
+      }
+      recordDecision(start, evaluated);
+      return true;
+   }
+
+   BotStats stats;
+
+private:
+   struct Node {
+      Board board;      // Tablero tras las colocaciones
+      int root;         // Colocación de la primera pieza de la que desciende
+      int lines;        // Líneas eliminadas en el camino
+      double score;     // Evaluación del tablero
+   };
+
+   ThreadPool &pool;
+   BotConfig config;
+   TranspositionTable *table;     // Caché compartida de evaluaciones y mejores jugadas (opcional)
+   MoveGenerator rootGenerator;
+   std::vector<Node> beam;
+   std::vector<std::vector<Node>> children;
+
+   double evaluate(const Board &board, int lines) {   // Evalúa el tablero usando la caché si está disponible
+      double linesTerm = config.weights.lines * lines;
+      if (!table) {
+         return evaluateBoard(board, 0, config.weights) + linesTerm;
+      }
+      TTData cached;
+      if (table->probe(board.hash, cached) && cached.depth == 0) {
+         return cached.score + linesTerm;
+      }
+      TTData entry;
+      entry.score = float(evaluateBoard(board, 0, config.weights));
+      table->store(board.hash, entry);
+      return entry.score + linesTerm;
+   }
+
+   void recordDecision(std::chrono::steady_clock::time_point start, uint64_t evaluated) {
+      double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+      stats.decisions++;
+      stats.nodes += evaluated;
+      stats.totalMs += ms;
+      stats.maxMs = std::max(stats.maxMs, ms);
+   }
+
+   void keepBest(std::vector<Node> &nodes) const {   // Conserva los beamWidth mejores nodos, el mejor al frente
+      size_t keep = std::min<size_t>(nodes.size(), std::max(1, config.beamWidth));
+      std::partial_sort(nodes.begin(), nodes.begin() + keep, nodes.end(), [](const Node &a, const Node &b) { return a.score > b.score; });
+      nodes.resize(keep);
+   }
+};
+
+using BeamSearchBot = BasicBeamSearchBot<StandardGeometry>;
+
+#endif
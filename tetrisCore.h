@@ -0,0 +1,553 @@
+// Núcleo del juego sin entrada/salida: tablero, piezas y estado de una partida.
+// No usa la consola ni el reloj del sistema, por lo que varias partidas pueden
+// convivir en el mismo proceso y avanzar tan rápido como se quiera.
+#ifndef TETRIS_CORE_H
+#define TETRIS_CORE_H
+
+#include <array>        // Arreglo de filas del tablero (bitboard)
+#include <cstdint>      // Tipos enteros de tamaño fijo para las máscaras de fila
+#include <random>       // Generador de piezas con semilla
+#include <algorithm>    // Funciones de utilidad como max()
+#include <type_traits>  // Comprobación de que Piece es un valor trivial
+#include <cstdlib>      // abs()
+
+// Dimensiones del tablero estándar y parámetros del juego
+const int WIDTH = 10, HEIGHT = 20;     // Dimensiones del tablero estándar
+const int PUNTOS_POR_LINEA = 100;      // Puntos por línea eliminada
+const int NIVEL_INCREMENTO = 5;        // Incremento de nivel
+const int VELOCIDAD_INICIAL = 500;     // Intervalo de caída inicial (ms)
+const int VELOCIDAD_MINIMA = 100;      // Velocidad minima
+const int TICK_MS = 10;                // Duración de un tick lógico (ms)
+const uint16_t FULL_MASK = (1u << WIDTH) - 1;   // Máscara de una fila completa del tablero estándar (un bit por columna)
+const int MAX_FILAS_PIEZA = 4;         // Máximo de filas que ocupa una pieza
+const int MAX_PIEZAS_PREVIAS = 6;      // Máximo de piezas próximas visibles (y que se distinguen en el hash)
+const int MAX_ANCHO_TABLERO = 60;      // Máximo ancho de una geometría (las filas caben en 64 bits junto a las patadas)
+const int MAX_ALTO_TABLERO = 64;       // Máximo alto de una geometría (una fila por bit en las máscaras de filas)
+
+// Palabra que guarda una fila de W columnas, elegida en compilación según el ancho
+template <int W>
+using RowBits = std::conditional_t<W <= 8, uint8_t, std::conditional_t<W <= 16, uint16_t, std::conditional_t<W <= 32, uint32_t, uint64_t>>>;
+
+// Geometría del tablero: ancho, alto total y filas visibles (las filas de arriba que sobran son la zona de reserva)
+template <int W, int H, int V = H>
+struct Geometry {
+   static_assert(W >= 4 && W <= MAX_ANCHO_TABLERO && H <= MAX_ALTO_TABLERO && V >= 4 && V <= H, "Geometría fuera de rango");
+   static constexpr int WIDTH = W, HEIGHT = H, VISIBLE = V;
+   static constexpr int SPAWN_ROW = H - V;     // Las piezas aparecen en la primera fila visible
+   using Row = RowBits<W>;
+   static constexpr Row FULL_MASK = Row((uint64_t(1) << W) - 1);
+};
+
+using StandardGeometry = Geometry<WIDTH, HEIGHT>;   // Tablero clásico de 10x20
+using TallGeometry = Geometry<10, 40, 20>;          // 10x40: 20 filas visibles y 20 de reserva para las patadas por encima
+using WideGeometry = Geometry<20, 40>;              // Modo ancho de 20x40
+
+// Geometrías que se pueden elegir al ejecutar (cada una compila su propia versión del núcleo)
+enum BoardVariant {BOARD_10X20, BOARD_10X40, BOARD_20X40};
+const int NUM_BOARD_VARIANTS = 3;
+inline constexpr const char *BOARD_VARIANT_NAMES[NUM_BOARD_VARIANTS] = {"10x20", "10x40", "20x40"};
+
+template <typename F>
+auto withGeometry(BoardVariant variant, F &&body) {   // Llama a body con un valor de la geometría elegida
+   switch (variant) {
+      case BOARD_10X40: return body(TallGeometry());
+      case BOARD_20X40: return body(WideGeometry());
+      default: return body(StandardGeometry());
+   }
+}
+
+// Enumeración para los tipos de Tetrominos (mismo orden que TETROMINO_SHAPES)
+enum Tetromino {I, O, T, L, J, S, Z};
+const int NUM_TETROMINOS = 7;          // Cantidad de Tetrominos distintos
+const int NUM_ROTACIONES = 4;          // Orientaciones posibles de cada pieza
+
+// Acciones que el jugador (o un programa) puede aplicar en un tick
+enum Action {NO_ACTION, MOVE_LEFT, MOVE_RIGHT, SOFT_DROP, ROTATE, HARD_DROP, TOGGLE_PAUSE};
+
+// Forma inicial de un Tetromino dentro de su caja de rotación SRS ('#' = celda ocupada)
+struct ShapeSpec {
+   int size;                              // Lado de la caja de rotación
+   const char *rows[MAX_FILAS_PIEZA];     // Filas de la forma en la orientación inicial
+};
+
+// Definición de las formas de los Tetrominos
+inline constexpr ShapeSpec TETROMINO_SHAPES[NUM_TETROMINOS] = {
+   {4, {"....", "####", "....", "...."}}, // I
+   {2, {"##", "##"}},                     // O
+   {3, {".#.", "###", "..."}},            // T
+   {3, {"#..", "###", "..."}},            // L
+   {3, {"..#", "###", "..."}},            // J
+   {3, {".##", "##.", "..."}},            // S
+   {3, {"##.", ".##", "..."}}             // Z
+};
+
+using RotationTable = std::array<std::array<std::array<uint16_t, MAX_FILAS_PIEZA>, NUM_ROTACIONES>, NUM_TETROMINOS>;
+
+constexpr RotationTable buildRotationTable() {   // Genera las cuatro orientaciones de cada forma en tiempo de compilación
+   RotationTable table{};
+   for (int type = 0; type < NUM_TETROMINOS; ++type) {
+      const ShapeSpec &spec = TETROMINO_SHAPES[type];
+      for (int rot = 0; rot < NUM_ROTACIONES; ++rot) {
+         for (int r = 0; r < spec.size; ++r) {
+            for (int c = 0; c < spec.size; ++c) {
+               int sr = r, sc = c;     // Celda de la forma inicial que cae en (r, c) tras 'rot' giros horarios
+               for (int k = 0; k < rot; ++k) {
+                  int prev = sr;
+                  sr = spec.size - 1 - sc;
+                  sc = prev;
+               }
+               table[type][rot][r] |= spec.rows[sr][sc] == '#' ? 1u << c : 0;
+            }
+         }
+      }
+   }
+   return table;
+}
+
+inline constexpr RotationTable PIECE_ROWS = buildRotationTable();    // Máscaras de fila por tipo y orientación (bit j = columna j de la caja)
+
+constexpr int firstFilledRow(int type) {   // Primera fila ocupada de la orientación inicial
+   int r = 0;
+   while (r < MAX_FILAS_PIEZA - 1 && PIECE_ROWS[type][0][r] == 0) {
+      ++r;
+   }
+   return r;
+}
+
+// Desplazamientos SRS (dx, dy) para la rotación horaria desde cada orientación (0->R, R->2, 2->L, L->0); dy positivo hacia abajo
+inline constexpr int KICKS_JLSTZ[NUM_ROTACIONES][5][2] = {
+   {{0, 0}, {-1, 0}, {-1, -1}, {0, 2}, {-1, 2}},
+   {{0, 0}, {1, 0}, {1, 1}, {0, -2}, {1, -2}},
+   {{0, 0}, {1, 0}, {1, -1}, {0, 2}, {1, 2}},
+   {{0, 0}, {-1, 0}, {-1, 1}, {0, -2}, {-1, -2}}
+};
+inline constexpr int KICKS_I[NUM_ROTACIONES][5][2] = {
+   {{0, 0}, {-2, 0}, {1, 0}, {-2, 1}, {1, -2}},
+   {{0, 0}, {-1, 0}, {2, 0}, {-1, -2}, {2, 1}},
+   {{0, 0}, {2, 0}, {-1, 0}, {2, -1}, {-1, 2}},
+   {{0, 0}, {1, 0}, {-2, 0}, {1, 2}, {-2, -1}}
+};
+
+inline uint64_t shiftRow(uint64_t mask, int x) {   // Desplaza la máscara de una fila de la pieza a la columna x del tablero
+   return x >= 0 ? mask << x : mask >> -x;
+}
+
+// Claves Zobrist: un número aleatorio fijo por celda, por pieza activa y por pieza de la vista previa
+template <typename G>
+struct ZobristKeys {
+   uint64_t cells[G::HEIGHT][G::WIDTH];
+   uint64_t pieces[NUM_TETROMINOS][NUM_ROTACIONES];
+   uint64_t preview[MAX_PIEZAS_PREVIAS][NUM_TETROMINOS];
+};
+
+constexpr uint64_t splitMix64(uint64_t &state) {   // Generador pseudoaleatorio simple, evaluable en compilación
+   uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+   z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+   z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+   return z ^ (z >> 31);
+}
+
+template <typename G>
+constexpr ZobristKeys<G> buildZobristKeys() {   // Genera las claves en tiempo de compilación (iguales en todas las ejecuciones)
+   ZobristKeys<G> keys{};
+   uint64_t state = 0x7E7215ull;
+   for (int y = 0; y < G::HEIGHT; ++y) {
+      for (int x = 0; x < G::WIDTH; ++x) {
+         keys.cells[y][x] = splitMix64(state);
+      }
+   }
+   for (int type = 0; type < NUM_TETROMINOS; ++type) {
+      for (int rot = 0; rot < NUM_ROTACIONES; ++rot) {
+         keys.pieces[type][rot] = splitMix64(state);
+      }
+   }
+   for (int slot = 0; slot < MAX_PIEZAS_PREVIAS; ++slot) {
+      for (int type = 0; type < NUM_TETROMINOS; ++type) {
+         keys.preview[slot][type] = splitMix64(state);
+      }
+   }
+   return keys;
+}
+
+template <typename G>
+inline constexpr ZobristKeys<G> ZOBRIST_KEYS = buildZobristKeys<G>();
+inline constexpr const ZobristKeys<StandardGeometry> &ZOBRIST = ZOBRIST_KEYS<StandardGeometry>;   // Claves del tablero estándar
+
+template <typename G = StandardGeometry>
+inline uint64_t rowHash(int y, uint64_t bits) {   // Contribución al hash de la fila y con las celdas indicadas
+   uint64_t hash = 0;
+   for (int x = 0; bits; ++x, bits >>= 1) {
+      hash ^= bits & 1 ? ZOBRIST_KEYS<G>.cells[y][x] : 0;
+   }
+   return hash;
+}
+
+// Estructura de datos para representar una pieza
+struct Piece {
+   Tetromino type = I;        // Tipo de Tetromino
+   int rotation = 0;          // Orientación actual (índice en PIECE_ROWS)
+   int x = 0, y = 0;          // Posición de la caja de rotación en el tablero
+
+   Piece() = default;
+   // Constructor para crear una pieza en la posición inicial de un tablero del ancho dado
+   Piece(Tetromino t, int boardWidth = WIDTH, int spawnRow = 0)
+      : type(t), rotation(0), x(boardWidth / 2 - TETROMINO_SHAPES[t].size / 2), y(spawnRow - firstFilledRow(t)) {}
+
+   const uint16_t *rows() const { return PIECE_ROWS[type][rotation].data(); }    // Máscaras de fila de la orientación actual
+};
+static_assert(std::is_trivially_copyable<Piece>::value, "Las piezas se copian como valores");
+
+// Tablero del juego: una palabra por fila, bit j = columna j. Las dimensiones son constantes
+// de compilación, así que los recorridos por filas y columnas se pueden desenrollar
+template <typename G>
+struct BasicBoard {
+   using Row = typename G::Row;
+   static constexpr int WIDTH = G::WIDTH, HEIGHT = G::HEIGHT;
+   static constexpr Row FULL_MASK = G::FULL_MASK;
+
+   std::array<Row, HEIGHT> rows{};
+   uint64_t hash = 0;      // Hash Zobrist de las celdas ocupadas, actualizado en cada colocación y limpieza
+
+   // Métricas mantenidas en cada colocación y limpieza (lectura en O(1))
+   std::array<uint8_t, WIDTH> columnHeights{};   // Altura de cada columna (0 = vacía)
+   std::array<uint8_t, WIDTH> columnCells{};     // Celdas ocupadas de cada columna
+   int aggregateHeight = 0;                      // Suma de las alturas
+   int bumpiness = 0;                            // Suma de las diferencias de altura entre columnas vecinas
+   int cellCount = 0;                            // Celdas ocupadas en todo el tablero
+   int touchedTop = 0, touchedBottom = HEIGHT - 1;   // Filas que tocó la última colocación (las únicas que pueden llenarse)
+
+   static Piece spawn(Tetromino type) { return Piece(type, WIDTH, G::SPAWN_ROW); }   // Pieza en su posición de aparición
+
+   bool operator==(const BasicBoard &other) const { return rows == other.rows; }
+
+   bool cell(int x, int y) const { return rows[y] >> x & 1; }    // Indica si la celda (x, y) está ocupada
+
+   int holes() const { return aggregateHeight - cellCount; }    // Celdas vacías bajo la cima de su columna
+
+   int maxHeight() const { return *std::max_element(columnHeights.begin(), columnHeights.end()); }
+
+   int wells() const {   // Suma de la profundidad de los pozos: columnas más bajas que ambas vecinas (las paredes cuentan como llenas)
+      int total = 0;
+      for (int x = 0; x < WIDTH; ++x) {
+         int left = x > 0 ? columnHeights[x - 1] : HEIGHT, right = x < WIDTH - 1 ? columnHeights[x + 1] : HEIGHT;
+         total += std::max(0, std::min(left, right) - columnHeights[x]);
+      }
+      return total;
+   }
+
+   bool canPlacePiece(const Piece &piece, int dx, int dy) const {    // Verifica si se puede colocar la pieza en la posición deseada
+      int newX = piece.x + dx, newY = piece.y + dy;                  // Calcula la nueva posición
+      if (newX >= WIDTH) {
+         return false;        // Toda la caja queda a la derecha (y el desplazamiento no sale de la palabra)
+      }
+      const uint16_t *shape = piece.rows();
+      for (int i = 0; i < MAX_FILAS_PIEZA; ++i) {
+         uint64_t mask = shape[i];
+         if (!mask) {
+            continue;         // Fila vacía de la forma
+         }
+         if (newY + i < 0 || newY + i >= HEIGHT) {
+            return false;     // Fuera del tablero por arriba o por abajo
+         }
+         if (newX < 0) {
+            if (mask & ((1u << -newX) - 1)) {
+               return false;  // Alguna celda queda a la izquierda del tablero
+            }
+            mask >>= -newX;
+         } else {
+            mask <<= newX;
+         }
+         if ((mask & ~uint64_t(FULL_MASK)) || (mask & rows[newY + i])) {
+            return false;     // Sale por la derecha o choca con una celda ocupada
+         }
+      }
+      return true;   // Retorna verdadero si la posición es válida
+   }
+
+   void placePiece(const Piece &piece) {     // Coloca la pieza en el tablero y actualiza las métricas de las columnas que toca
+      const uint16_t *shape = piece.rows();
+      int left = std::max(0, piece.x - 1), right = std::min(WIDTH - 2, piece.x + MAX_FILAS_PIEZA - 1);   // Pares de columnas vecinas afectados
+      bumpiness -= pairBumpiness(left, right);
+      touchedTop = HEIGHT;
+      touchedBottom = -1;
+      for (int i = 0; i < MAX_FILAS_PIEZA; ++i) {
+         if (!shape[i]) {
+            continue;
+         }
+         int y = piece.y + i;
+         Row mask = Row(shiftRow(shape[i], piece.x));
+         rows[y] |= mask;                                   // Actualiza el tablero con la máscara de la fila
+         hash ^= rowHash<G>(y, mask);                          // Agrega las celdas nuevas al hash
+         touchedTop = std::min(touchedTop, y);
+         touchedBottom = y;
+         for (int k = 0; k < MAX_FILAS_PIEZA; ++k) {
+            if (shape[i] >> k & 1) {
+               int x = piece.x + k;
+               columnCells[x]++;
+               cellCount++;
+               if (HEIGHT - y > columnHeights[x]) {
+                  aggregateHeight += HEIGHT - y - columnHeights[x];
+                  columnHeights[x] = uint8_t(HEIGHT - y);
+               }
+            }
+         }
+      }
+      bumpiness += pairBumpiness(left, right);
+   }
+
+   void fillCell(int x, int y) {     // Ocupa una sola celda (tableros iniciales cargados de un archivo) y actualiza las métricas
+      if (cell(x, y)) {
+         return;
+      }
+      int left = std::max(0, x - 1), right = std::min(WIDTH - 2, x);
+      bumpiness -= pairBumpiness(left, right);
+      rows[y] |= Row(Row(1) << x);
+      hash ^= rowHash<G>(y, uint64_t(1) << x);
+      columnCells[x]++;
+      cellCount++;
+      if (HEIGHT - y > columnHeights[x]) {
+         aggregateHeight += HEIGHT - y - columnHeights[x];
+         columnHeights[x] = uint8_t(HEIGHT - y);
+      }
+      bumpiness += pairBumpiness(left, right);
+   }
+
+   int clearFullLines() {    // Limpia las líneas completas entre las filas que tocó la última colocación y retorna cuántas se eliminaron
+      int lowest = -1;       // Fila completa más baja
+      for (int i = touchedBottom; i >= touchedTop && lowest < 0; --i) {
+         lowest = rows[i] == FULL_MASK ? i : -1;
+      }
+      touchedTop = HEIGHT;   // Las filas no pueden volver a llenarse sin otra colocación
+      touchedBottom = -1;
+      if (lowest < 0) {
+         return 0;           // Caso común: la pieza no completó ninguna línea
+      }
+      int stackTop = HEIGHT - maxHeight();   // Por encima de esta fila no hay celdas
+      int dest = lowest;     // Fila destino al compactar desde abajo hacia arriba (las filas de abajo no cambian)
+      int cleared = 0;       // Líneas completas encontradas
+      for (int i = lowest; i >= stackTop; --i) {
+         if (rows[i] == FULL_MASK) {      // Verifica si la línea está completa
+            cleared++;
+            hash ^= rowHash<G>(i, FULL_MASK);
+         } else {
+            if (dest != i && rows[i]) {
+               hash ^= rowHash<G>(i, rows[i]) ^ rowHash<G>(dest, rows[i]);   // Solo cambian las filas que se desplazan
+            }
+            rows[dest--] = rows[i];       // Baja la fila sobre las líneas eliminadas
+         }
+      }
+      while (dest >= stackTop) {
+         rows[dest--] = 0;                // Agrega líneas vacías en la parte superior
+      }
+      // Cada línea eliminada tenía una celda en cada columna, así que ninguna cima estaba por debajo de ella:
+      // la altura baja exactamente 'cleared', salvo si la cima misma se eliminó y quedó un hueco debajo
+      aggregateHeight = 0;
+      cellCount -= cleared * WIDTH;
+      for (int x = 0; x < WIDTH; ++x) {
+         columnCells[x] -= cleared;
+         int height = columnHeights[x] - cleared;
+         while (height > 0 && !cell(x, HEIGHT - height)) {
+            height--;
+         }
+         columnHeights[x] = uint8_t(height);
+         aggregateHeight += height;
+      }
+      bumpiness = pairBumpiness(0, WIDTH - 2);
+      return cleared;
+   }
+
+   bool rotatePiece(Piece &piece) const {    // Rota la pieza en sentido horario aplicando las patadas SRS
+      if (piece.type == O) {
+         return true;   // La O no cambia al rotar
+      }
+      Piece rotated = piece;                                   // Copia local: la rotación no reserva memoria
+      rotated.rotation = (piece.rotation + 1) % NUM_ROTACIONES;
+      const int (*kicks)[2] = piece.type == I ? KICKS_I[piece.rotation] : KICKS_JLSTZ[piece.rotation];
+      for (int k = 0; k < 5; ++k) {                            // Prueba cada desplazamiento en orden
+         if (canPlacePiece(rotated, kicks[k][0], kicks[k][1])) {
+            piece.rotation = rotated.rotation;
+            piece.x += kicks[k][0];
+            piece.y += kicks[k][1];
+            return true;
+         }
+      }
+      return false;     // Mantiene la orientación original si ningún desplazamiento es válido
+   }
+
+private:
+   int pairBumpiness(int left, int right) const {   // Diferencias de altura de los pares (x, x + 1) con x en [left, right]
+      int sum = 0;
+      for (int x = left; x <= right; ++x) {
+         sum += std::abs(columnHeights[x] - columnHeights[x + 1]);
+      }
+      return sum;
+   }
+};
+
+using Board = BasicBoard<StandardGeometry>;
+
+// Cola de piezas próximas de capacidad fija: un buffer circular sin memoria dinámica
+class PieceQueue {
+public:
+   void clear() { head = count = 0; }
+   int size() const { return count; }
+   const Piece &front() const { return slots[head]; }
+   const Piece &operator[](int i) const { return slots[(head + i) % MAX_PIEZAS_PREVIAS]; }   // i = 0 es la próxima pieza
+
+   void push(const Piece &piece) {   // Agrega al final; la cola nunca supera MAX_PIEZAS_PREVIAS
+      slots[(head + count) % MAX_PIEZAS_PREVIAS] = piece;
+      count++;
+   }
+
+   Piece pop() {   // Saca la pieza del frente
+      Piece piece = slots[head];
+      head = (head + 1) % MAX_PIEZAS_PREVIAS;
+      count--;
+      return piece;
+   }
+
+private:
+   std::array<Piece, MAX_PIEZAS_PREVIAS> slots;
+   int head = 0, count = 0;
+};
+
+// Inicializa el generador de piezas con los 64 bits de la semilla. Las semillas menores
+// que 2^32 lo inicializan directamente, como antes, así que repiten las mismas partidas
+inline void seedPieceGenerator(std::mt19937 &rng, uint64_t seed) {
+   if (seed >> 32 == 0) {
+      rng.seed(static_cast<std::mt19937::result_type>(seed));
+      return;
+   }
+   std::seed_seq sequence{uint32_t(seed), uint32_t(seed >> 32)};
+   rng.seed(sequence);
+}
+
+// Estado completo de una partida. Avanza únicamente mediante step(), en ticks lógicos de TICK_MS
+template <typename G>
+struct BasicGameState {
+   using Board = BasicBoard<G>;
+
+   Board board;                                          // Tablero del juego
+   Piece activePiece;                                    // Pieza que controla el jugador
+   PieceQueue upcomingPieces;                            // Cola para manejar las piezas próximas
+   int previewLength = 1;                                // Piezas próximas visibles (1 a MAX_PIEZAS_PREVIAS)
+   int score = 0, linesCleared = 0, level = 1, speed = VELOCIDAD_INICIAL;   // Estadísticas del juego
+   bool isPaused = false, gameOver = false;              // Estado del juego
+   uint64_t tick = 0;                                    // Ticks lógicos transcurridos
+   uint64_t piecesPlaced = 0;                            // Piezas fijadas en el tablero
+   int ticksSinceDrop = 0;                               // Ticks desde la última caída por gravedad
+   std::mt19937 rng;                                     // Generador de piezas (determinista para una semilla)
+
+   explicit BasicGameState(uint64_t seed, int preview = 1) : previewLength(std::min(std::max(preview, 1), MAX_PIEZAS_PREVIAS)) { reset(seed); }
+
+   void reset(uint64_t seed) {   // Reinicia el estado del tablero y las estadísticas
+      board = Board();
+      score = linesCleared = 0;
+      level = 1;
+      speed = VELOCIDAD_INICIAL;
+      isPaused = gameOver = false;
+      tick = piecesPlaced = 0;
+      ticksSinceDrop = 0;
+      seedPieceGenerator(rng, seed);
+      upcomingPieces.clear();
+      activePiece = createRandomPiece();                 // Crea la pieza activa
+      while (upcomingPieces.size() < previewLength) {
+         upcomingPieces.push(createRandomPiece());       // Llena la vista previa (misma secuencia para cualquier longitud)
+      }
+   }
+
+   const Piece &nextPiece() const { return upcomingPieces.front(); }    // Próxima pieza de la cola
+
+   uint64_t hash() const {   // Hash Zobrist del tablero, la pieza activa con su orientación y la vista previa
+      uint64_t hash = board.hash ^ ZOBRIST_KEYS<G>.pieces[activePiece.type][activePiece.rotation];
+      for (int slot = 0; slot < upcomingPieces.size(); ++slot) {
+         hash ^= ZOBRIST_KEYS<G>.preview[slot][upcomingPieces[slot].type];
+      }
+      return hash;
+   }
+
+   Piece createRandomPiece() {   // Crea una pieza Tetromino aleatoria
+      std::uniform_int_distribution<> distrib(0, NUM_TETROMINOS - 1);   // Distribución uniforme
+      return Board::spawn(static_cast<Tetromino>(distrib(rng)));
+   }
+
+   void apply(Action action) {   // Aplica una acción del jugador sin avanzar el tiempo
+      if (gameOver) {
+         return;
+      }
+      if (action == TOGGLE_PAUSE) {
+         isPaused = !isPaused;   // Cambia el estado de pausa
+         return;
+      }
+      if (isPaused) {
+         return;
+      }
+      switch (action) {
+         case MOVE_LEFT:
+            activePiece.x -= board.canPlacePiece(activePiece, -1, 0) ? 1 : 0;   // Mueve la pieza a la izquierda
+            break;
+         case MOVE_RIGHT:
+            activePiece.x += board.canPlacePiece(activePiece, 1, 0) ? 1 : 0;    // Mueve la pieza a la derecha
+            break;
+         case SOFT_DROP:
+            activePiece.y += board.canPlacePiece(activePiece, 0, 1) ? 1 : 0;    // Mueve la pieza hacia abajo
+            break;
+         case ROTATE:
+            board.rotatePiece(activePiece);                                    // Rota la pieza
+            break;
+         case HARD_DROP:
+            while (board.canPlacePiece(activePiece, 0, 1)) {
+               activePiece.y++;                                                 // Coloca la pieza en la parte más baja posible
+            }
+            break;
+         default:
+            break;
+      }
+   }
+
+   void advance() {   // Avanza un tick lógico: aplica la gravedad cuando corresponde
+      if (gameOver || isPaused) {
+         return;
+      }
+      tick++;
+      if (++ticksSinceDrop * TICK_MS < speed) {
+         return;
+      }
+      ticksSinceDrop = 0;
+      if (board.canPlacePiece(activePiece, 0, 1)) {
+         activePiece.y++;                                   // Mueve la pieza hacia abajo
+      } else {
+         lockPiece();
+      }
+   }
+
+   int ticksUntilDrop() const {   // Llamadas a advance() que faltan para la próxima caída por gravedad
+      return std::max(1, (speed + TICK_MS - 1) / TICK_MS - ticksSinceDrop);
+   }
+
+   void step(Action action) {   // Aplica la acción y avanza un tick
+      apply(action);
+      advance();
+   }
+
+   void lockPiece() {   // Fija la pieza activa, limpia líneas y saca la siguiente de la cola
+      board.placePiece(activePiece);                        // Coloca la pieza en el tablero
+      piecesPlaced++;
+      int cleared = board.clearFullLines();                 // Limpia las líneas completas
+      for (int n = 0; n < cleared; ++n) {
+         score += PUNTOS_POR_LINEA;                                                          // Incrementa el puntaje
+         linesCleared++;                                                                     // Incrementa el número de líneas eliminadas
+         level = linesCleared % NIVEL_INCREMENTO == 0 ? level + 1 : level;                         // Incrementa el nivel si se han eliminado suficientes líneas
+         speed = linesCleared % NIVEL_INCREMENTO == 0 ? std::max(VELOCIDAD_MINIMA, speed - 25) : speed; // Aumenta la velocidad del juego
+      }
+      activePiece = upcomingPieces.pop();                   // La próxima pieza se convierte en la activa
+      upcomingPieces.push(createRandomPiece());             // Repone la cola de piezas próximas
+      if (!board.canPlacePiece(activePiece, 0, 0)) {
+         gameOver = true;                                   // Termina el juego si no se puede colocar la pieza
+      }
+   }
+};
+
+using GameState = BasicGameState<StandardGeometry>;
+
+#endif
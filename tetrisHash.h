@@ -0,0 +1,131 @@
+// Tabla de transposición de tamaño fijo para las búsquedas sobre colocaciones.
+// Cada entrada guarda la clave combinada con los datos (clave ^ datos), de modo que
+// varios hilos pueden leer y escribir sin bloqueos: una escritura a medias simplemente
+// no coincide con la clave y se trata como un fallo.
+#ifndef TETRIS_HASH_H
+#define TETRIS_HASH_H
+
+#include <atomic>       // Entradas y contadores sin bloqueos
+#include <memory>       // Arreglo de entradas
+#include <cstring>      // memcpy() para empaquetar la evaluación
+
+#include "tetrisCore.h"  // Claves Zobrist, tablero y piezas
+
+// Hash de una posición de búsqueda: tablero, pieza por colocar (orientación inicial) y piezas siguientes
+template <typename G>
+uint64_t positionHash(const BasicBoard<G> &board, const Tetromino *pieces, int count) {
+   uint64_t hash = board.hash ^ ZOBRIST_KEYS<G>.pieces[pieces[0]][0];
+   for (int slot = 0; slot + 1 < count && slot < MAX_PIEZAS_PREVIAS; ++slot) {
+      hash ^= ZOBRIST_KEYS<G>.preview[slot][pieces[slot + 1]];
+   }
+   return hash;
+}
+
+// Datos guardados para una posición
+struct TTData {
+   float score = 0;           // Evaluación en caché
+   int8_t depth = 0;          // Profundidad con la que se calculó (0 = evaluación estática)
+   bool hasMove = false;      // Indica si la entrada guarda una mejor jugada
+   Piece move;                // Mejor colocación encontrada (tipo, orientación y posición)
+};
+
+// Estadísticas de uso de la tabla
+struct TTStats {
+   uint64_t probes = 0, hits = 0, stores = 0;
+   uint64_t collisions = 0;   // Consultas que encontraron la ranura ocupada por otra posición
+   uint64_t overwrites = 0;   // Escrituras que reemplazaron otra posición
+
+   double hitRate() const { return probes ? double(hits) / probes : 0; }
+};
+
+class TranspositionTable {
+public:
+   explicit TranspositionTable(size_t megabytes) {
+      size_t entries = 1;
+      while (entries * 2 * sizeof(Entry) <= megabytes * 1024 * 1024) {
+         entries *= 2;     // Potencia de dos para indexar con una máscara
+      }
+      mask = entries - 1;
+      table.reset(new Entry[entries]);
+   }
+
+   size_t sizeBytes() const { return (mask + 1) * sizeof(Entry); }
+
+   bool probe(uint64_t key, TTData &out) {   // Busca la posición; verdadero si estaba en la tabla
+      Entry &entry = table[key & mask];
+      uint64_t data = entry.data.load(std::memory_order_relaxed);
+      uint64_t check = entry.check.load(std::memory_order_relaxed);
+      probes.fetch_add(1, std::memory_order_relaxed);
+      if (data == 0) {
+         return false;     // Ranura vacía
+      }
+      if ((check ^ data) != key) {
+         collisions.fetch_add(1, std::memory_order_relaxed);
+         return false;
+      }
+      hits.fetch_add(1, std::memory_order_relaxed);
+      out = unpack(data);
+      return true;
+   }
+
+   void store(uint64_t key, const TTData &value) {   // Guarda (o reemplaza) los datos de la posición
+      Entry &entry = table[key & mask];
+      uint64_t data = pack(value);
+      uint64_t previous = entry.data.load(std::memory_order_relaxed);
+      if (previous != 0 && (entry.check.load(std::memory_order_relaxed) ^ previous) != key) {
+         overwrites.fetch_add(1, std::memory_order_relaxed);
+      }
+      entry.check.store(key ^ data, std::memory_order_relaxed);
+      entry.data.store(data, std::memory_order_relaxed);
+      stores.fetch_add(1, std::memory_order_relaxed);
+   }
+
+   TTStats stats() const {
+      TTStats result;
+      result.probes = probes.load();
+      result.hits = hits.load();
+      result.stores = stores.load();
+      result.collisions = collisions.load();
+      result.overwrites = overwrites.load();
+      return result;
+   }
+
+private:
+   struct Entry {
+      std::atomic<uint64_t> check{0};   // Clave ^ datos
+      std::atomic<uint64_t> data{0};    // Datos empaquetados (nunca 0 si la entrada está ocupada)
+   };
+
+   std::unique_ptr<Entry[]> table;
+   uint64_t mask = 0;
+   std::atomic<uint64_t> probes{0}, hits{0}, stores{0}, collisions{0}, overwrites{0};
+
+   // Formato: evaluación (32 bits) | profundidad (8) | libres (3) | tipo (3) | rotación (2) | x + 8 (7) | y + 8 (7) | jugada (1) | ocupada (1)
+   static_assert(MAX_ANCHO_TABLERO + 8 < 128 && MAX_ALTO_TABLERO + 8 < 128, "La posición de la jugada no cabe en 7 bits");
+
+   static uint64_t pack(const TTData &value) {
+      uint32_t bits;
+      std::memcpy(&bits, &value.score, sizeof(bits));
+      uint64_t data = uint64_t(bits) << 32;
+      data |= uint64_t(uint8_t(value.depth)) << 24;
+      data |= uint64_t(value.move.type) << 18 | uint64_t(value.move.rotation) << 16;
+      data |= uint64_t(value.move.x + 8) << 9 | uint64_t(value.move.y + 8) << 2;
+      data |= uint64_t(value.hasMove) << 1 | 1;
+      return data;
+   }
+
+   static TTData unpack(uint64_t data) {
+      TTData value;
+      uint32_t bits = uint32_t(data >> 32);
+      std::memcpy(&value.score, &bits, sizeof(bits));
+      value.depth = int8_t(data >> 24 & 0xFF);
+      value.move.type = static_cast<Tetromino>(data >> 18 & 7);
+      value.move.rotation = int(data >> 16 & 3);
+      value.move.x = int(data >> 9 & 127) - 8;
+      value.move.y = int(data >> 2 & 127) - 8;
+      value.hasMove = data >> 1 & 1;
+      return value;
+   }
+};
+
+#endif
@@ -0,0 +1,166 @@
+// Generador de colocaciones alcanzables y conteo tipo "perft".
+// Explora con BFS los estados (x, y, rotación) a los que se llega con las mismas
+// acciones que acepta el jugador, incluidos deslizamientos bajo salientes y giros.
+#ifndef TETRIS_MOVES_H
+#define TETRIS_MOVES_H
+
+#include <vector>       // Listas de colocaciones y caminos
+#include <bitset>       // Estados visitados durante la búsqueda
+#include <array>        // Buffers de tamaño fijo
+#include <algorithm>    // Funciones de utilidad como reverse()
+
+#include "tetrisCore.h"  // Tablero, piezas y acciones
+
+// Acciones que el generador prueba desde cada estado
+inline constexpr Action GENERATOR_MOVES[] = {MOVE_LEFT, MOVE_RIGHT, SOFT_DROP, ROTATE, HARD_DROP};
+
+// Colocación final de una pieza (ya no puede bajar más)
+struct Placement {
+   Piece piece;            // Posición y orientación en reposo
+   uint64_t footprint;     // Celdas que ocupa: fila superior y máscaras de fila (identifica colocaciones equivalentes)
+   int state;              // Estado de la búsqueda que la generó (para reconstruir el camino)
+};
+
+inline uint64_t pieceFootprint(const Piece &piece) {   // Codifica las celdas de la pieza en el tablero como un entero (independiente del ancho)
+   const uint16_t *shape = piece.rows();
+   int top = 0, left = MAX_FILAS_PIEZA;
+   while (shape[top] == 0) {
+      ++top;
+   }
+   for (int i = top; i < MAX_FILAS_PIEZA; ++i) {
+      for (int c = 0; c < left; ++c) {
+         left = shape[i] >> c & 1 ? c : left;     // Primera columna ocupada de la caja
+      }
+   }
+   uint64_t key = uint64_t(piece.y + top + 8) << 7 | uint64_t(piece.x + left + 8);   // Celda superior izquierda (desplazada para que sea positiva)
+   for (int i = top; i < top + MAX_FILAS_PIEZA; ++i) {
+      key = key << 4 | (i < MAX_FILAS_PIEZA ? shape[i] >> left : 0);                  // Forma normalizada contra esa celda
+   }
+   return key;
+}
+
+template <typename G>
+class BasicMoveGenerator {
+public:
+   using Board = BasicBoard<G>;
+
+   // Rango de posiciones de la caja de rotación que pueden ser válidas
+   static constexpr int MIN_X = -3, MIN_Y = -3;
+   static constexpr int SPAN_X = G::WIDTH + 3, SPAN_Y = G::HEIGHT + 3;
+   static constexpr int NUM_STATES = SPAN_X * SPAN_Y * NUM_ROTACIONES;
+
+   // Llena 'out' con todas las colocaciones distintas alcanzables desde la aparición de la pieza
+   void generate(const Board &board, Tetromino type, std::vector<Placement> &out) {
+      out.clear();
+      visited.reset();
+      int head = 0, tail = 0;
+      Piece spawn = Board::spawn(type);
+      if (!board.canPlacePiece(spawn, 0, 0)) {
+         return;     // La pieza no cabe: fin de la partida
+      }
+      int start = stateIndex(spawn);
+      visited.set(start);
+      parent[start] = -1;
+      frontier[tail++] = spawn;
+      while (head < tail) {
+         Piece current = frontier[head++];
+         int index = stateIndex(current);
+         if (!board.canPlacePiece(current, 0, 1)) {
+            addPlacement(current, index, out);   // Estado en reposo: colocación final
+         }
+         for (Action move : GENERATOR_MOVES) {
+            Piece next = current;
+            if (!applyMove(board, next, move)) {
+               continue;
+            }
+            int nextIndex = stateIndex(next);
+            if (!visited.test(nextIndex)) {
+               visited.set(nextIndex);
+               parent[nextIndex] = index;
+               parentMove[nextIndex] = move;
+               frontier[tail++] = next;
+            }
+         }
+         nodes++;
+      }
+   }
+
+   // Acciones que llevan la pieza desde su aparición hasta la colocación (válido tras generate())
+   std::vector<Action> pathTo(const Placement &placement) const {
+      std::vector<Action> path;
+      for (int s = placement.state; parent[s] >= 0; s = parent[s]) {
+         path.push_back(parentMove[s]);
+      }
+      std::reverse(path.begin(), path.end());
+      return path;
+   }
+
+   uint64_t nodes = 0;     // Estados expandidos en total (para medir rendimiento)
+
+private:
+   std::bitset<NUM_STATES> visited;
+   std::array<int, NUM_STATES> parent{};
+   std::array<Action, NUM_STATES> parentMove{};
+   std::array<Piece, NUM_STATES> frontier{};   // Cola de la BFS
+
+   static int stateIndex(const Piece &piece) {
+      return ((piece.y - MIN_Y) * SPAN_X + (piece.x - MIN_X)) * NUM_ROTACIONES + piece.rotation;
+   }
+
+   static bool applyMove(const Board &board, Piece &piece, Action move) {   // Aplica un movimiento; falso si la pieza no cambia
+      switch (move) {
+         case MOVE_LEFT:
+            return board.canPlacePiece(piece, -1, 0) && (piece.x--, true);
+         case MOVE_RIGHT:
+            return board.canPlacePiece(piece, 1, 0) && (piece.x++, true);
+         case SOFT_DROP:
+            return board.canPlacePiece(piece, 0, 1) && (piece.y++, true);
+         case ROTATE:
+            return piece.type != O && board.rotatePiece(piece);
+         case HARD_DROP: {
+            int startY = piece.y;
+            while (board.canPlacePiece(piece, 0, 1)) {
+               piece.y++;
+            }
+            return piece.y != startY;
+         }
+         default:
+            return false;
+      }
+   }
+
+   static void addPlacement(const Piece &piece, int state, std::vector<Placement> &out) {   // Agrega la colocación si su huella es nueva
+      uint64_t footprint = pieceFootprint(piece);
+      for (const Placement &p : out) {
+         if (p.footprint == footprint) {
+            return;     // Misma huella alcanzada con otra orientación o camino
+         }
+      }
+      out.push_back({piece, footprint, state});
+   }
+};
+
+using MoveGenerator = BasicMoveGenerator<StandardGeometry>;
+
+// Cuenta las secuencias de colocaciones de longitud 'depth' siguiendo la secuencia de piezas dada
+template <typename G>
+uint64_t perft(const BasicBoard<G> &board, const Tetromino *sequence, int depth, BasicMoveGenerator<G> &generator, std::vector<std::vector<Placement>> &buffers) {
+   if (depth == 0) {
+      return 1;
+   }
+   std::vector<Placement> &placements = buffers[depth];     // Un buffer por nivel para no reservar memoria en cada nodo
+   generator.generate(board, sequence[0], placements);
+   if (depth == 1) {
+      return placements.size();
+   }
+   uint64_t total = 0;
+   for (size_t i = 0; i < placements.size(); ++i) {
+      BasicBoard<G> child = board;
+      child.placePiece(placements[i].piece);
+      child.clearFullLines();
+      total += perft(child, sequence + 1, depth - 1, generator, buffers);
+   }
+   return total;
+}
+
+#endif
@@ -0,0 +1,85 @@
+// Perfilado opcional del bucle del juego por cuadro.
+// Al compilar con -DTETRIS_PERFILAR_CUADROS, gameLoop mide con temporizadores de
+// alcance cuánto tarda cada cuadro en leer la entrada, avanzar la lógica y renderizar,
+// y guarda cada fase en un histograma que se imprime al terminar la partida. Sin la
+// opción los temporizadores están vacíos y no hay ningún costo.
+#ifndef TETRIS_PROFILE_H
+#define TETRIS_PROFILE_H
+
+#include <cstdint>      // Tipos enteros de tamaño fijo
+#include <chrono>       // Reloj monotónico (también en Windows)
+#include <ostream>      // Impresión del informe
+
+#include "tetrisTerminal.h" // Histograma de latencias
+
+// Fases de un cuadro del bucle del juego
+enum FramePhase {PHASE_INPUT, PHASE_LOGIC, PHASE_RENDER};
+const int NUM_PHASES = 3;
+inline constexpr const char *FRAME_PHASE_NAMES[NUM_PHASES] = {"Entrada", "Lógica", "Renderizado"};
+
+#ifdef TETRIS_PERFILAR_CUADROS
+const bool FRAME_PROFILING = true;
+#else
+const bool FRAME_PROFILING = false;
+#endif
+
+// Tiempo por fase de cada cuadro: las mediciones de una fase dentro del mismo cuadro se
+// suman (p. ej. la gravedad y la jugada del bot son ambas lógica) y se registran al cerrarlo
+class FrameProfile {
+public:
+   void add(FramePhase phase, uint64_t ns) { current[phase] += ns; }
+
+   void endFrame() {
+      if (!FRAME_PROFILING) {
+         return;
+      }
+      for (int p = 0; p < NUM_PHASES; ++p) {
+         histograms[p].record(current[p]);
+         totalNs[p] += current[p];
+         current[p] = 0;
+      }
+      frames++;
+   }
+
+   void print(std::ostream &out) const {
+      out << "Tiempo por cuadro (" << frames << " cuadros):\n";
+      for (int p = 0; p < NUM_PHASES; ++p) {
+         out << FRAME_PHASE_NAMES[p] << ": media " << (frames ? totalNs[p] / 1000.0 / frames : 0) << " us\n";
+         histograms[p].print(out, FRAME_PHASE_NAMES[p]);
+      }
+   }
+
+   uint64_t frames = 0;
+
+private:
+   uint64_t current[NUM_PHASES] = {};
+   uint64_t totalNs[NUM_PHASES] = {};
+   LatencyHistogram histograms[NUM_PHASES];
+};
+
+// Mide el tiempo hasta el final del bloque y lo suma a la fase indicada del cuadro en curso
+#ifdef TETRIS_PERFILAR_CUADROS
+class ScopedTimer {
+public:
+   ScopedTimer(FrameProfile &profile, FramePhase phase) : profile(profile), phase(phase), start(std::chrono::steady_clock::now()) {}
+
+   ~ScopedTimer() {
+      profile.add(phase, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+   }
+
+   ScopedTimer(const ScopedTimer &) = delete;
+   ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+private:
+   FrameProfile &profile;
+   FramePhase phase;
+   std::chrono::steady_clock::time_point start;
+};
+#else
+class ScopedTimer {
+public:
+   ScopedTimer(FrameProfile &, FramePhase) {}
+};
+#endif
+
+#endif
@@ -1,11 +1,15 @@
 #include <iostream>     // Manejo de entrada/salida estándar
-#include <vector>       // Uso de vectores para las piezas y el tablero
-#include <random>       // Uso de números aleatorios para la posición inicial de las piezas
+#include <vector>       // Listas de piezas y caminos
+#include <string>       // Opciones de línea de comandos
+#include <random>       // Semilla aleatoria para cada partida
 #include <thread>       // Manejo de hilos para pausas y temporización
 #include <chrono>       // Gestión precisa de tiempo
-#include <algorithm>    // Funciones de utilidad como all_of() y fill()
-#include <queue>        // Cola para manejar las piezas próximas
+#include <algorithm>    // Funciones de utilidad como equal()
 #include <csignal>      // Manejo de señales para terminar el programa
+#include <memory>       // unique_ptr para la tabla de transposición
+#include <filesystem>   // Recorrido de directorios de repeticiones
+#include <atomic>       // Contadores de la verificación en paralelo
+#include <fstream>      // Tableros iniciales del solucionador
 #include <locale.h>     // configura la localización de la aplicación para trabajar con un idioma y formato específicos
 
 // Libreria para multiplataformas
@@ -15,83 +19,168 @@
 #else
 #include <termios.h> // Captura de teclas en Linux/Unix
 #include <unistd.h> // Funciones del sistema en Linux/Unix
+#include <poll.h> // Espera de eventos de teclado y temporizador
+#include <cerrno> // EINTR al recibir señales
+#ifdef __linux__
+#include <sys/timerfd.h> // Temporizador de gravedad como descriptor de archivo
+#endif
 #endif
 
-using namespace std;
-
-// Dimensiones del tablero y parámetros del juego
-const int WIDTH = 10, HEIGHT = 20;     // Dimensiones del tablero
-const int PUNTOS_POR_LINEA = 100;      // Puntos por línea eliminada
-const int NIVEL_INCREMENTO = 5;        // Incremento de nivel
-const int VELOCIDAD_MINIMA = 100;      // Velocidad minima 
-
-// Enumeración para los tipos de Tetrominos
-enum Tetromino {I, J, L, O, S, T, Z};
-
-// Definición de las formas de los Tetrominos
-const vector<vector<vector<int>>> TETROMINO_SHAPES = {
-   {{1, 1, 1, 1}},         // I
-   {{1, 1}, {1, 1}},       // O
-   {{0, 1, 0}, {1, 1, 1}}, // T
-   {{1, 0, 0}, {1, 1, 1}}, // L
-   {{0, 0, 1}, {1, 1, 1}}, // J
-   {{0, 1, 1}, {1, 1, 0}}, // S
-   {{1, 1, 0}, {0, 1, 1}}  // Z
-};
+#include "tetrisCore.h"  // Núcleo del juego: tablero, piezas y estado de la partida
+#include "tetrisMoves.h" // Generador de colocaciones y perft
+#include "tetrisBot.h"   // Jugador automático con búsqueda en haz
+#include "tetrisSimd.h"  // Kernels por lotes (SSE4.1/AVX2)
+#include "tetrisRender.h" // Renderizador de terminal por diferencias de celdas
+#include "tetrisTerminal.h" // Modo crudo, decodificación de teclas e histograma de latencia
+#include "tetrisReplay.h" // Grabación y reproducción de partidas
+#include "tetrisAlloc.h" // Conteo opcional de reservas de memoria (-DTETRIS_CONTAR_ASIGNACIONES)
+#include "tetrisServer.h" // Servidor de partidas epoll y generador de carga (solo Linux)
+#include "tetrisTrainer.h" // Entrenador genético de los pesos de evaluación
+#include "tetrisProfile.h" // Tiempos por fase de cada cuadro (-DTETRIS_PERFILAR_CUADROS)
+#include "tetrisSolver.h" // Solucionador exhaustivo de perfect clear
 
-// Estructura de datos para representar una pieza
-struct Piece {
-   vector<vector<int>> shape; // Forma de la pieza
-   int x, y;                  // Posición de la pieza en el tablero
+using namespace std;
 
-   // Constructor para crear una pieza aleatoria
-   Piece(Tetromino type) : shape(TETROMINO_SHAPES[type]), x(WIDTH / 2 - shape[0].size() / 2), y(0) {}
-   // Constructor para crear una pieza con forma y posición específicas
-   Piece(const vector<vector<int>> &newShape, int startX, int startY) : shape(newShape), x(startX), y(startY) {}
+// Opciones de línea de comandos
+struct Options {
+   bool autoplay = false;                          // El jugador automático controla las piezas
+   unsigned threads = thread::hardware_concurrency();   // Hilos para la búsqueda
+   BotConfig bot;                                  // Ancho y profundidad del haz
+   size_t tableMegabytes = 16;                     // Tamaño de la tabla de transposición (0 = sin caché)
+   string recordPath = "ultima_partida.ttr";       // Archivo donde se graba la partida (vacío = no grabar)
+   int preview = 1;                                // Piezas próximas visibles (1 a MAX_PIEZAS_PREVIAS)
+   BoardVariant board = BOARD_10X20;               // Geometría del tablero
 };
 
 // Declaración de variables globales
-vector<vector<int>> board(HEIGHT, vector<int>(WIDTH, 0));         // Tablero del juego      
-int score = 0, linesCleared = 0, level = 1, speed = 500;          // Estadísticas del juego
-queue<Piece *> upcomingPieces;                                    // Cola para manejar las piezas próximas
-bool gameCancelled = false;                                       // Variable global para manejar la cancelación del juego
+atomic<bool> gameCancelled{false};                                // Variable global para manejar la cancelación del juego (también la leen los hilos del servidor)
 
 // === Declaración de Funciones ===
 // Funciones de visualización y manejo del juego
 void displayTitleScreen();       // Muestra la pantalla de bienvenida
-void resetGame();                // Reinicia el estado del juego
 void clearConsole();             // Limpia la consola
 
-// Funciones de renderización del juego
-void renderGame(const Piece *activePiece, const Piece *nextPiece, bool isPaused);   // Renderiza el estado del juego
-
-// Funciones de mecánica del juego
-Piece *createRandomPiece();                                 // Crea una pieza Tetromino aleatoria
-bool canPlacePiece(const Piece *piece, int dx, int dy);     // Verifica si se puede colocar la pieza
-void placePiece(const Piece *piece);                        // Coloca la pieza en el tablero
-void clearFullLines();                                      // Limpia las líneas completas del tablero     
-void rotatePiece(Piece *piece);                             // Rota la pieza activa 
-
 // Funciones de entrada del usuario
-char getKeyPress();                                      // Obtiene la tecla presionada por el usuario
-void handleInput(Piece *activePiece, bool &isPaused);    // Maneja la entrada del usuario        
+char getKeyPress();              // Obtiene la tecla presionada por el usuario
+#ifdef _WIN32
+Action handleInput();            // Traduce la tecla presionada a una acción del juego
+#endif
 
 // Función principal del juego
-void gameLoop();                                         // Inicia el ciclo principal del juego
+template <typename G>
+void gameLoop(const Options &options);   // Inicia el ciclo principal del juego con la geometría G
+template <typename G>
+void playBotMove(BasicBeamSearchBot<G> &bot, BasicGameState<G> &game, ReplayRecorder &recorder, uint64_t &plannedPiece);   // Decide y aplica la jugada del bot para la pieza activa
+template <typename G>
+void applyRecorded(BasicGameState<G> &game, ReplayRecorder &recorder, Action action);   // Aplica una acción y la graba
+
+// Herramientas sin interfaz
+int runPerft(int depth, uint64_t seed);          // Cuenta secuencias de colocaciones hasta la profundidad dada
+int runSimdBenchmark(int rounds);                // Compara los kernels por lotes con la versión escalar
+int runReplay(const char *path);                 // Reproduce una partida grabada y la verifica
+int runVerifyDirectory(const char *path, unsigned threads);   // Verifica todas las repeticiones de un directorio en paralelo
+int runAllocationCheck(int ticks);               // Comprueba que el ciclo de juego no reserva memoria
+int runBoardBenchmark(int games);                // Verifica las métricas incrementales y mide colocar y limpiar
+int runTrainer(const char *checkpoint, int generations, const TrainerConfig &config);   // Entrena los pesos de evaluación y guarda un punto de control por generación
+int runSolver(const char *boardPath, const char *sequence, int height, unsigned threads);   // Busca un perfect clear (o el máximo de líneas) con piezas conocidas
+#ifdef __linux__
+int runServer(const char *address, unsigned reactors, double seconds);   // Sirve partidas por socket con un reactor epoll por núcleo
+int runLoadGenerator(const char *address, int sessions, double seconds, double actionsPerSecond);   // Abre muchas sesiones y mide la latencia de confirmación
+#endif
 
 // Funciones de finalización del juego
-void freePieceMemory(Piece *activePiece, Piece *nextPiece);       // Libera la memoria de las piezas
-void displayGameOver();                                           // Muestra el mensaje de Game Over
-void signalHandler(int signum);                                   // Maneja señales del sistema
+template <typename G>
+void displayGameOver(const BasicGameState<G> &game);    // Muestra el mensaje de Game Over
+void signalHandler(int signum);                 // Maneja señales del sistema
 
-int main() {
+int main(int argc, char *argv[]) {
    setlocale(LC_ALL, "es_ES.UTF-8");            // Establecer el idioma de la consola
+   if (argc >= 3 && string(argv[1]) == "--perft") {   // tetrisProject --perft <profundidad> [semilla]
+      return runPerft(stoi(argv[2]), argc >= 4 ? stoull(argv[3]) : 1);
+   }
+   if (argc >= 2 && string(argv[1]) == "--bench-simd") {   // tetrisProject --bench-simd [rondas]
+      return runSimdBenchmark(argc >= 3 ? stoi(argv[2]) : 2000);
+   }
+   if (argc >= 3 && string(argv[1]) == "--replay") {   // tetrisProject --replay <archivo.ttr>
+      return runReplay(argv[2]);
+   }
+   if (argc >= 3 && string(argv[1]) == "--verify") {   // tetrisProject --verify <directorio> [hilos]
+      return runVerifyDirectory(argv[2], argc >= 4 ? stoi(argv[3]) : thread::hardware_concurrency());
+   }
+   if (argc >= 2 && string(argv[1]) == "--bench-board") {   // tetrisProject --bench-board [partidas]
+      return runBoardBenchmark(argc >= 3 ? stoi(argv[2]) : 200);
+   }
+   if (argc >= 2 && string(argv[1]) == "--alloc-check") {   // tetrisProject --alloc-check [ticks]
+      return runAllocationCheck(argc >= 3 ? stoi(argv[2]) : 100000);
+   }
+   if (argc >= 3 && string(argv[1]) == "--train") {   // tetrisProject --train <punto_de_control> [generaciones] [población] [partidas] [piezas]
+      TrainerConfig config;
+      config.population = argc >= 5 ? stoi(argv[4]) : config.population;
+      config.games = argc >= 6 ? stoi(argv[5]) : config.games;
+      config.maxPieces = argc >= 7 ? stoi(argv[6]) : config.maxPieces;
+      signal(SIGINT, signalHandler);               // Ctrl + C termina tras la generación en curso
+      return runTrainer(argv[2], argc >= 4 ? stoi(argv[3]) : 50, config);
+   }
+   if (argc >= 4 && string(argv[1]) == "--solve") {   // tetrisProject --solve <tablero.txt|vacio> <piezas, p. ej. IOTLJSZ> [altura] [hilos]
+      signal(SIGINT, signalHandler);               // Ctrl + C corta la búsqueda y muestra lo mejor hallado
+      return runSolver(argv[2], argv[3], argc >= 5 ? stoi(argv[4]) : 4, argc >= 6 ? stoi(argv[5]) : thread::hardware_concurrency());
+   }
+#ifdef __linux__
+   if (argc >= 3 && string(argv[1]) == "--server") {   // tetrisProject --server <unix:/ruta|[host:]puerto> [reactores] [segundos]
+      signal(SIGINT, signalHandler);
+      return runServer(argv[2], argc >= 4 ? stoi(argv[3]) : thread::hardware_concurrency(), argc >= 5 ? stod(argv[4]) : 0);
+   }
+   if (argc >= 4 && string(argv[1]) == "--loadgen") {   // tetrisProject --loadgen <dirección> <sesiones> [segundos] [acciones/s por sesión]
+      signal(SIGINT, signalHandler);
+      return runLoadGenerator(argv[2], stoi(argv[3]), argc >= 5 ? stod(argv[4]) : 10, argc >= 6 ? stod(argv[5]) : 5);
+   }
+#endif
+   Options options;
+   for (int i = 1; i < argc; ++i) {             // tetrisProject [--autoplay] [--beam N] [--depth N] [--threads N] [--tt-mb N] [--record archivo|--no-record] [--preview N] [--board 10x20|10x40|20x40] [--weights altura,líneas,huecos,rugosidad,pozos]
+      string arg = argv[i];
+      if (arg == "--autoplay") {
+         options.autoplay = true;
+      } else if (arg == "--beam" && i + 1 < argc) {
+         options.bot.beamWidth = stoi(argv[++i]);
+      } else if (arg == "--depth" && i + 1 < argc) {
+         options.bot.depth = stoi(argv[++i]);
+      } else if (arg == "--tt-mb" && i + 1 < argc) {
+         options.tableMegabytes = stoul(argv[++i]);
+      } else if (arg == "--threads" && i + 1 < argc) {
+         options.threads = stoi(argv[++i]);
+      } else if (arg == "--record" && i + 1 < argc) {
+         options.recordPath = argv[++i];
+      } else if (arg == "--no-record") {
+         options.recordPath.clear();
+      } else if (arg == "--preview" && i + 1 < argc) {
+         options.preview = stoi(argv[++i]);
+      } else if (arg == "--board" && i + 1 < argc) {
+         string name = argv[++i];
+         auto known = find(begin(BOARD_VARIANT_NAMES), end(BOARD_VARIANT_NAMES), name);
+         if (known == end(BOARD_VARIANT_NAMES)) {
+            cerr << "Tablero desconocido: " << name << " (10x20, 10x40 o 20x40)\n";
+            return 1;
+         }
+         options.board = static_cast<BoardVariant>(known - begin(BOARD_VARIANT_NAMES));
+      } else if (arg == "--weights" && i + 1 < argc) {   // Pesos del bot, p. ej. los que imprime --train
+         WeightVector weights;
+         if (sscanf(argv[++i], "%lf,%lf,%lf,%lf,%lf", &weights[0], &weights[1], &weights[2], &weights[3], &weights[4]) != NUM_PESOS) {
+            cerr << "Pesos no válidos: " << argv[i] << " (cinco números separados por comas)\n";
+            return 1;
+         }
+         options.bot.weights = fromVector(weights);
+      } else {
+         cerr << "Opción desconocida: " << arg << "\n";
+         return 1;
+      }
+   }
    signal(SIGINT, signalHandler);               // Manejar interrupciones con Ctrl + C           
    displayTitleScreen();                        // Mostrar pantalla de bienvenida
    getKeyPress();                               // Esperar una tecla para iniciar
    clearConsole();                              // Limpiar la consola
-   resetGame();                                 // Reiniciar variables del juego
-   gameLoop();                                  // Iniciar el ciclo principal del juego
+   withGeometry(options.board, [&](auto geometry) {
+      gameLoop<decltype(geometry)>(options);    // Iniciar el ciclo principal del juego
+   });
    cout << "\nGracias por jugar Tetris!\n";
    return 0;
 }
@@ -113,18 +202,6 @@ void displayTitleScreen() {   // Muestra la pantalla de bienvenida.
          << "Presiona Enter para comenzar...\n";   // Instrucciones para el jugador
 }
 
-void resetGame() {   // Reinicia el estado del tablero y las estadísticas
-   board.assign(HEIGHT, vector<int>(WIDTH, 0));    // Reinicia el tablero    
-   score = linesCleared = 0;                       // Reinicia el puntaje y líneas eliminadas     
-   level = 1;                                      // Reinicia el nivel
-   speed = 500;                                    // Velocidad inicial del juego
-   while (!upcomingPieces.empty()) {
-      upcomingPieces.pop();                        // Limpia la cola de piezas próximas
-   }
-   upcomingPieces.push(createRandomPiece());       // Agrega una pieza aleatoria a la cola
-   clearConsole();
-}
-
 void clearConsole() {   // Limpia la pantalla
    #ifdef _WIN32
       system("cls");  // Limpia la pantalla en Windows
@@ -133,229 +210,738 @@ void clearConsole() {   // Limpia la pantalla
    #endif
 }
 
-void renderGame(const Piece *activePiece, const Piece *nextPiece, bool isPaused) {  // Renderiza el tablero y las piezas
-   static vector<string> previousScreen;     // Almacena la pantalla anterior para optimizar la renderización
-   vector<string> currentScreen(HEIGHT + 10);   // Pantalla actual
-
-   for (int i = 0; i < HEIGHT; ++i) {  // Construcción visual del tablero (filas)
-      string row = "<|";
-      for (int j = 0; j < WIDTH; ++j) { // Construcción visual del tablero (columnas)
-         bool isPiece = false;      // Bandera para verificar si hay una pieza en la posición
-         for (int pi = 0; pi < activePiece->shape.size(); ++pi) {
-            for (int pj = 0; pj < activePiece->shape[pi].size(); ++pj) {
-               if (activePiece->shape[pi][pj] && activePiece->y + pi == i && activePiece->x + pj == j) {
-                  isPiece = true;   // Se encontró una pieza en la posición
-                  break;
-               }
-            } if (isPiece) {
-               break;
-            }
+char getKeyPress() {    // Obtiene la tecla presionada por el usuario
+#ifdef _WIN32
+   return _getch();     // Captura la tecla en Windows
+#else
+   struct termios oldt, newt;    // Configuración para capturar teclas en Linux/Unix
+   char ch;
+   tcgetattr(STDIN_FILENO, &oldt);
+   newt = oldt;
+   newt.c_lflag &= ~(ICANON | ECHO);     // Desactiva el modo canónico y el eco
+   tcsetattr(STDIN_FILENO, TCSANOW, &newt);
+   ch = getchar();      // Captura la tecla
+   tcsetattr(STDIN_FILENO, TCSANOW, &oldt);     // Restaura la configuración anterior
+   return ch;
+#endif
+}
+
+#ifdef _WIN32
+Action handleInput() {     // Procesa los comandos del jugador
+   if (_kbhit()) {                                          // Verifica si hay una tecla presionada
+      int key = getch();                                    // Obtiene la tecla presionada
+      if (key == 0 || key == 224) {                         // Verifica si la tecla es una tecla de función
+         int arrowKey = getch();                            // Obtiene la tecla de flecha
+         switch (arrowKey) {
+            case 75: return MOVE_LEFT;                      // Flecha izquierda
+            case 77: return MOVE_RIGHT;                     // Flecha derecha
+            case 80: return SOFT_DROP;                      // Flecha abajo
+            case 72: return ROTATE;                         // Flecha arriba (rotar la pieza)
+         }
+      } else if (key == 'p' || key == 'P') {                // Pausar/reanudar
+         return TOGGLE_PAUSE;
+      } else if (key == 'a') {                              // 'a' para mover izquierda
+         return MOVE_LEFT;
+      } else if (key == 'd') {                              // 'd' para mover derecha
+         return MOVE_RIGHT;
+      } else if (key == 's') {                              // 's' para bajar
+         return SOFT_DROP;
+      } else if (key == 'w') {                              // 'w' para rotar
+         return ROTATE;
+      } else if (key == ' ') {                              // Barra espaciadora para colocar la pieza
+         return HARD_DROP;
+      }
+   }
+   return NO_ACTION;
+}
+#endif
+
+template <typename G>
+void gameLoop(const Options &options) {    // Bucle principal del juego: conduce el núcleo con un tick cada TICK_MS
+   cout << "\033[?25l" << flush;                         // Oculta el cursor
+   BasicTerminalRenderer<G> renderer;                    // Buffers de pantalla reservados una sola vez
+   random_device device;
+   uint64_t seed = uint64_t(device()) << 32 | device();
+   BasicGameState<G> game(seed, options.preview);        // Partida nueva con semilla aleatoria
+   ReplayRecorder recorder(seed, options.board);                        // Semilla y acciones con su tick para repetir la partida
+   ThreadPool pool(options.autoplay ? options.threads : 1);
+   unique_ptr<TranspositionTable> table(options.autoplay && options.tableMegabytes ? new TranspositionTable(options.tableMegabytes) : nullptr);
+   BasicBeamSearchBot<G> bot(pool, options.bot, table.get());
+   uint64_t plannedPiece = ~0ull;                        // Pieza para la que el bot ya decidió
+   LatencyHistogram latency;                             // Desde que llega una tecla hasta que el cuadro está en pantalla
+   uint64_t wakeups = 0;                                 // Veces que el bucle despertó
+   AllocationStats allocations;                          // Reservas por cuadro (solo con TETRIS_CONTAR_ASIGNACIONES)
+   uint64_t setupAllocations = allocationCount();
+   FrameProfile profile;                                 // Entrada, lógica y renderizado por cuadro (solo con TETRIS_PERFILAR_CUADROS)
+
+#ifdef _WIN32
+   auto started = chrono::steady_clock::now();
+   auto nextTick = started;                              // Momento del próximo tick
+   while (!game.gameOver && !gameCancelled) {    // Bucle del juego
+      uint64_t allocated = allocationCount();
+      {
+         ScopedTimer measure(profile, PHASE_RENDER);
+         renderer.render(game);                  // Renderiza el estado del juego
+      }
+      Action action;
+      {
+         ScopedTimer measure(profile, PHASE_INPUT);
+         action = handleInput();                 // Lee la entrada del usuario
+      }
+      {
+         ScopedTimer measure(profile, PHASE_LOGIC);
+         if (options.autoplay && !game.isPaused) {
+            playBotMove(bot, game, recorder, plannedPiece);
+         }
+         applyRecorded(game, recorder, action);  // Aplica la entrada
+         game.advance();                         // Avanza un tick
+      }
+      allocations.frame(allocationCount() - allocated);
+      profile.endFrame();
+      wakeups++;
+      nextTick += chrono::milliseconds(TICK_MS);
+      this_thread::sleep_until(nextTick);        // Espera al siguiente tick para no consumir CPU
+   }
+   double seconds = chrono::duration<double>(chrono::steady_clock::now() - started).count();
+#else
+   // El hilo duerme en poll() sobre la entrada y un temporizador armado para la próxima caída por
+   // gravedad: no despierta mientras no haya teclas ni caídas, y en pausa espera solo al teclado
+   RawTerminal terminal;                                 // Modo crudo mientras se juega (se restaura antes del resumen final)
+   KeyDecoder decoder;
+#ifdef __linux__
+   int timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+#else
+   int timer = -1;                                       // Sin timerfd: se usa el tiempo límite de poll()
+#endif
+   uint64_t started = monotonicNs();
+   uint64_t consumed = 0;                                // Ticks lógicos ya aplicados al núcleo
+   const uint64_t tickNs = TICK_MS * 1000000ull;
+   renderer.render(game);
+   while (!game.gameOver && !gameCancelled) {    // Bucle del juego
+      uint64_t deadline = started + (consumed + game.ticksUntilDrop()) * tickNs;   // Próxima caída por gravedad
+      int timeout = -1;
+      if (timer >= 0) {
+         itimerspec when{};                      // Desarmado mientras el juego está en pausa
+         if (!game.isPaused) {
+            when.it_value.tv_sec = deadline / 1000000000ull;
+            when.it_value.tv_nsec = deadline % 1000000000ull;
+         }
+         timerfd_settime(timer, TFD_TIMER_ABSTIME, &when, nullptr);
+      } else if (!game.isPaused) {
+         uint64_t now = monotonicNs();
+         timeout = deadline > now ? int((deadline - now + 999999) / 1000000) : 0;
+      }
+      pollfd fds[2] = {{STDIN_FILENO, POLLIN, 0}, {timer, POLLIN, 0}};
+      if (poll(fds, timer >= 0 ? 2 : 1, timeout) < 0) {
+         if (errno == EINTR) {
+            continue;                            // Señal (Ctrl + C): se revisa gameCancelled
+         }
+         break;
+      }
+      uint64_t woke = monotonicNs();
+      uint64_t allocated = allocationCount();
+      wakeups++;
+      {
+         ScopedTimer measure(profile, PHASE_LOGIC);
+         if (timer >= 0 && (fds[1].revents & POLLIN)) {
+            uint64_t expirations;
+            ssize_t ignored = read(timer, &expirations, sizeof(expirations));   // Vacía el contador del temporizador
+            (void)ignored;
+         }
+         uint64_t target = (woke - started) / tickNs;   // Ticks que corresponden al tiempo real transcurrido
+         if (game.isPaused) {
+            consumed = target;                   // El tiempo en pausa no cuenta para la gravedad
          }
-         row += (isPiece || board[i][j]) ? "[]" : ".."; // Representación visual de las piezas y el tablero
-      }
-
-      row += "|>";
-      row += i == 1 ? "   Puntaje: " + to_string(score) : "";                    // Muestra el puntaje
-      row += i == 2 ? "   Líneas eliminadas: " + to_string(linesCleared) : "";   // Muestra líneas eliminadas
-      row += i == 3 ? "   Nivel: " + to_string(level) : "";                      // Muestra el nivel
-      row += i == 5 ? "   Próxima pieza:" : "";                                  // Indica la próxima pieza
-      if (i >= 6 && i < 6 + 4) {    // Renderiza la próxima pieza
-         row += "   ";
-         int offsetRow = i - 6;
-         for (int pj = 0; pj < 4; ++pj) {
-            row += (offsetRow < nextPiece->shape.size() && pj < nextPiece->shape[offsetRow].size() && nextPiece->shape[offsetRow][pj]) ? "[]" : "  "; // Representación visual de la próxima pieza
+         while (consumed < target && !game.gameOver) {
+            game.advance();
+            consumed++;
+         }
+      }
+
+      bool pressed = false;
+      if (fds[0].revents & POLLIN) {
+         ScopedTimer measure(profile, PHASE_INPUT);
+         char bytes[64];
+         Action actions[64];
+         ssize_t n = read(STDIN_FILENO, bytes, sizeof(bytes));   // Una lectura por despertar: si quedó algo, poll() vuelve enseguida
+         if (n == 0) {
+            break;                               // Fin de la entrada (no es una terminal)
+         }
+         if (n > 0) {
+            int count = decoder.decode(bytes, int(n), actions);
+            for (int k = 0; k < count; ++k) {
+               applyRecorded(game, recorder, actions[k]);   // Las teclas se aplican al instante, sin esperar al tick
+            }
+            pressed = true;
          }
+      } else if (fds[0].revents & (POLLHUP | POLLERR)) {
+         break;                                  // La entrada se cerró
       }
-      row += i == 11 ? "   Controles:" : "";
-      if (i >= 12 && i <= 17) {     // Muestra los controles
-         const char *controls[] = {"     W: Rotar", "     A: Mover a la izquierda", "     D: Mover a la derecha", "     S: Caída rápida", "     ESPACIO: Caída instantánea", "     P: Pausar/Reanudar"};
-         row += controls[i - 12];
+      if (options.autoplay && !game.isPaused) {
+         ScopedTimer measure(profile, PHASE_LOGIC);
+         playBotMove(bot, game, recorder, plannedPiece);
       }
-      currentScreen[i] = row;    // Almacena la fila en la pantalla actual
+      {
+         ScopedTimer measure(profile, PHASE_RENDER);
+         renderer.render(game);
+      }
+      if (pressed) {
+         latency.record(monotonicNs() - woke);
+      }
+      allocations.frame(allocationCount() - allocated);
+      profile.endFrame();
    }
-   currentScreen[HEIGHT] = "<|" + string(WIDTH * 2, '=') + "|>";
-   if (isPaused) {      // Si el juego está en pausa
-      currentScreen[HEIGHT + 2] = " |====================|";
-      currentScreen[HEIGHT + 3] = " |  JUEGO EN PAUSA    |";
-      currentScreen[HEIGHT + 4] = " |====================|";
-   } else {
-      fill(currentScreen.begin() + HEIGHT + 2, currentScreen.begin() + HEIGHT + 5, string(WIDTH * 2 + 3, ' '));   // Limpia el área de pausa
+   if (timer >= 0) {
+      close(timer);
    }
-   for (int i = 0; i < currentScreen.size(); ++i) {   // Renderiza la pantalla actual
-      if (previousScreen.empty() || i >= previousScreen.size() || currentScreen[i] != previousScreen[i]) {
-         cout << "\033[" << i + 1 << ";1H" << currentScreen[i];   // Mueve el cursor y muestra la fila
+   double seconds = (monotonicNs() - started) / 1e9;
+   terminal.restore();                           // El resumen se imprime con eco y modo canónico
+#endif
+
+   displayGameOver(game);                        // Muestra el mensaje de Game Over
+   if (!options.recordPath.empty()) {
+      if (recorder.save(options.recordPath.c_str(), game)) {
+         cout << "Partida grabada en " << options.recordPath << " (" << recorder.actions << " acciones)\n";
+      } else {
+         cout << "No se pudo grabar la partida en " << options.recordPath << "\n";
+      }
+   }
+   cout << "Renderizado: " << renderer.stats.frames << " cuadros (" << renderer.stats.skippedFrames << " sin cambios), "
+        << renderer.stats.bytesPerFrame() << " bytes/cuadro, " << renderer.stats.averageUs() << " us/cuadro (máx. "
+        << renderer.stats.maxNs / 1000 << " us)\n";
+   cout << "Despertares del bucle: " << wakeups << " (" << (seconds > 0 ? wakeups / seconds : 0) << " por segundo)\n";
+   latency.print(cout, "Latencia de entrada a pantalla");
+   if (ALLOCATION_COUNTING) {
+      cout << "Reservas de memoria: " << setupAllocations << " al preparar, " << allocations.total << " durante la partida ("
+           << allocations.framesWithAllocations << " de " << allocations.frames << " cuadros, máx. "
+           << allocations.maxPerFrame << " por cuadro)\n";
+   }
+   if (FRAME_PROFILING) {
+      profile.print(cout);
+   }
+   if (options.autoplay) {
+      cout << "Jugador automático: " << bot.stats.decisions << " piezas, "
+           << bot.stats.nodesPerSecond() / 1e6 << " M nodos/s, latencia media "
+           << bot.stats.averageMs() << " ms, máxima " << bot.stats.maxMs << " ms ("
+           << pool.size() << " hilos)\n";
+      if (table) {
+         TTStats tt = table->stats();
+         cout << "Tabla de transposición (" << table->sizeBytes() / (1024 * 1024) << " MB): "
+              << tt.probes << " consultas, " << tt.hitRate() * 100 << "% aciertos, "
+              << tt.collisions << " colisiones, " << tt.overwrites << " reemplazos, "
+              << bot.stats.cachedDecisions << " decisiones desde caché\n";
       }
    }
-   previousScreen = currentScreen;  // Actualiza la pantalla anterior
 }
 
-Piece *createRandomPiece() {  // Crea una pieza Tetromino aleatoria
-   static random_device rd;
-   static mt19937 gen(rd());          // Generador basado en Mersenne Twister
-   static uniform_int_distribution<> distrib(0, TETROMINO_SHAPES.size() - 1); // Distribución uniforme
+template <typename G>
+void applyRecorded(BasicGameState<G> &game, ReplayRecorder &recorder, Action action) {   // Solo se graban las acciones que pueden cambiar el estado
+   if (action != NO_ACTION && !game.gameOver) {
+      recorder.record(game.tick, action);
+   }
+   game.apply(action);
+}
 
-   return new Piece(static_cast<Tetromino>(distrib(gen)));  // Generar un índice aleatorio y crear la pieza
+template <typename G>
+void playBotMove(BasicBeamSearchBot<G> &bot, BasicGameState<G> &game, ReplayRecorder &recorder, uint64_t &plannedPiece) {   // Una sola decisión por pieza
+   if (plannedPiece == game.piecesPlaced) {
+      return;
+   }
+   Tetromino pieces[1 + MAX_PIEZAS_PREVIAS] = {game.activePiece.type};   // Pieza activa y toda la vista previa
+   int count = 1;
+   for (int k = 0; k < game.upcomingPieces.size(); ++k) {
+      pieces[count++] = game.upcomingPieces[k].type;
+   }
+   vector<Action> path;
+   if (bot.choose(game.board, pieces, count, path)) {
+      for (Action move : path) {
+         applyRecorded(game, recorder, move);    // Lleva la pieza a la colocación elegida dentro del mismo tick
+      }
+   }
+   plannedPiece = game.piecesPlaced;
 }
 
-bool canPlacePiece(const Piece *piece, int dx, int dy) {    // Verifica si se puede colocar la pieza en la posición deseada
-   for (int i = 0; i < piece->shape.size(); ++i) {
-      for (int j = 0; j < piece->shape[i].size(); ++j) {
-         if (piece->shape[i][j]) {
-            int newX = piece->x + j + dx, newY = piece->y + i + dy;     // Calcula la nueva posición
-            if (newX < 0 || newX >= WIDTH || newY < 0 || newY >= HEIGHT || board[newY][newX]) {
-               return false;     // Retorna falso si la posición es inválida
+int runPerft(int depth, uint64_t seed) {   // Cuenta las secuencias de colocaciones desde un tablero vacío y una semilla fija
+   GameState game(seed);                     // Secuencia de piezas determinista para la semilla
+   vector<Tetromino> sequence = {game.activePiece.type, game.nextPiece().type};
+   while ((int)sequence.size() < depth) {
+      sequence.push_back(game.createRandomPiece().type);
+   }
+   MoveGenerator generator;
+   vector<vector<Placement>> buffers(depth + 1);
+   cout << "perft semilla " << seed << "\n";
+   for (int d = 1; d <= depth; ++d) {
+      generator.nodes = 0;
+      auto start = chrono::steady_clock::now();
+      uint64_t count = perft(game.board, sequence.data(), d, generator, buffers);
+      double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+      cout << "profundidad " << d << ": " << count << " secuencias, "
+           << generator.nodes << " estados, " << seconds * 1000 << " ms, "
+           << (seconds > 0 ? generator.nodes / seconds / 1e6 : 0) << " M estados/s\n";
+   }
+   return 0;
+}
+
+int runSimdBenchmark(int rounds) {   // Mide el rendimiento de los kernels por lotes sobre las mismas entradas
+   const int NUM_LOTES = 64;
+   vector<BoardBatch> boards(NUM_LOTES);
+   vector<PieceBatch> pieces(NUM_LOTES);
+   vector<uint32_t> expected(NUM_LOTES);    // Colisiones según canPlacePiece
+   mt19937 rng(12345);                      // Entradas fijas para poder comparar entre ejecuciones
+   MoveGenerator generator;
+   vector<Placement> placements;
+   for (int b = 0; b < NUM_LOTES; ++b) {
+      for (int lane = 0; lane < BATCH_LANES; ++lane) {
+         Board board;                       // Tablero de media partida: colocaciones aleatorias alcanzables
+         int count = rng() % 40;
+         for (int n = 0; n < count; ++n) {
+            generator.generate(board, static_cast<Tetromino>(rng() % NUM_TETROMINOS), placements);
+            if (placements.empty()) {
+               break;
             }
+            board.placePiece(placements[rng() % placements.size()].piece);
+            board.clearFullLines();
+         }
+         boards[b].set(lane, board);
+         Piece piece(static_cast<Tetromino>(rng() % NUM_TETROMINOS));   // Pieza en una columna y orientación aleatorias
+         piece.rotation = rng() % NUM_ROTACIONES;
+         piece.y = 0;
+         while (piece.rows()[-piece.y] == 0) {
+            piece.y--;                      // Primera fila ocupada en la fila 0 del tablero
          }
+         Board empty;
+         if (lane % 8 == 7) {
+            piece.x = int(rng() % (WIDTH + 6)) - 3;    // Uno de cada ocho carriles puede salir por cualquier borde
+            piece.y = int(rng() % (HEIGHT + 6)) - 3;
+         } else {
+            do {
+               piece.x = int(rng() % (WIDTH + 3)) - 3;
+            } while (!empty.canPlacePiece(piece, 0, 0));
+         }
+         pieces[b].set(lane, piece);
+         expected[b] |= board.canPlacePiece(piece, 0, 0) ? 0 : 1u << lane;
       }
    }
-   return true;   // Retorna verdadero si la posición es válida
-}
 
-void placePiece(const Piece *piece) {     // Coloca la pieza en el tablero
-   for (int i = 0; i < piece->shape.size(); ++i) {
-      for (int j = 0; j < piece->shape[i].size(); ++j) {
-         board[piece->y + i][piece->x + j] = piece->shape[i][j] ? 1 : board[piece->y + i][piece->x + j]; // Actualiza el tablero
+   SimdLevel best = detectSimdLevel();
+   cout << "Nivel SIMD detectado: " << simdLevelName(best) << "\n";
+   vector<BatchResult> reference(NUM_LOTES);
+   double scalarRate = 0;
+   for (int level = SIMD_SCALAR; level <= best; ++level) {
+      vector<BatchResult> results(NUM_LOTES);
+      auto start = chrono::steady_clock::now();
+      for (int r = 0; r < rounds; ++r) {
+         for (int b = 0; b < NUM_LOTES; ++b) {
+            runBatch(static_cast<SimdLevel>(level), boards[b], pieces[b], results[b]);
+         }
+      }
+      double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+      double rate = double(rounds) * NUM_LOTES * BATCH_LANES / seconds;   // Tableros procesados por segundo
+      bool same = true;
+      for (int b = 0; b < NUM_LOTES; ++b) {
+         if (level == SIMD_SCALAR) {
+            reference[b] = results[b];
+         }
+         same = same && results[b].collisions == reference[b].collisions && results[b].collisions == expected[b]
+                && equal(begin(results[b].landing), end(results[b].landing), begin(reference[b].landing))
+                && equal(begin(results[b].fullRows), end(results[b].fullRows), begin(reference[b].fullRows));
+      }
+      scalarRate = level == SIMD_SCALAR ? rate : scalarRate;
+      cout << simdLevelName(static_cast<SimdLevel>(level)) << ": " << rate / 1e6 << " M tableros/s, x"
+           << rate / scalarRate << (same ? "" : "  [RESULTADOS DISTINTOS]") << "\n";
+      if (!same) {
+         return 1;
       }
    }
+   return 0;
 }
 
-void clearFullLines() {    // Limpia las líneas completas del tablero
-   for (int i = 0; i < HEIGHT; ++i) { // Busca líneas completas
-      if (all_of(board[i].begin(), board[i].end(), [](int cell) { return cell == 1; })) {    // Verifica si la línea está completa
-         board.erase(board.begin() + i);                                                     // Elimina la línea completa
-         board.insert(board.begin(), vector<int>(WIDTH, 0));                                 // Agrega una nueva línea vacía
-         score += PUNTOS_POR_LINEA;                                                          // Incrementa el puntaje
-         linesCleared++;                                                                     // Incrementa el número de líneas eliminadas
-         level = linesCleared % NIVEL_INCREMENTO == 0 ? level + 1 : level;                         // Incrementa el nivel si se han eliminado suficientes líneas
-         speed = linesCleared % NIVEL_INCREMENTO == 0 ? max(VELOCIDAD_MINIMA, speed - 25) : speed; // Aumenta la velocidad del juego
-      }
+int runReplay(const char *path) {   // Reproduce la partida a máxima velocidad y la compara con el pie del archivo
+   MappedFile file(path);
+   if (!file.ok()) {
+      cerr << "No se pudo abrir " << path << "\n";
+      return 1;
    }
+   auto start = chrono::steady_clock::now();
+   ReplayResult result = playReplay(file.data(), file.size());
+   double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+   if (result.error) {
+      cerr << path << ": " << result.error << "\n";
+      return 1;
+   }
+   cout << path << ": tablero " << BOARD_VARIANT_NAMES[result.variant] << ", semilla " << result.seed << ", " << result.actions << " acciones, " << result.ticks << " ticks, puntaje "
+        << result.score << ", " << result.linesCleared << " líneas, " << seconds * 1000 << " ms ("
+        << (seconds > 0 ? result.ticks / seconds / 1e6 : 0) << " M ticks/s) " << (result.matches ? "OK" : "DISTINTA") << "\n";
+   return result.matches ? 0 : 1;
 }
 
-void rotatePiece(Piece *piece) {    // Rota la pieza activa
-   vector<vector<int>> rotated(piece->shape[0].size(), vector<int>(piece->shape.size()));    // Crea una nueva matriz para la pieza rotada
-   for (int i = 0; i < piece->shape.size(); ++i) {                                           // Rota la pieza
-      for (int j = 0; j < piece->shape[i].size(); ++j) {
-         rotated[j][piece->shape.size() - i - 1] = piece->shape[i][j];     // Rota la pieza 90 grados
+int runVerifyDirectory(const char *path, unsigned threads) {   // Reproduce todas las repeticiones .ttr del directorio repartidas entre los hilos
+   vector<string> files;
+   error_code error;
+   for (const filesystem::directory_entry &entry : filesystem::directory_iterator(path, error)) {
+      if (entry.is_regular_file() && entry.path().extension() == ".ttr") {
+         files.push_back(entry.path().string());
       }
    }
-   // Verifica si la pieza rotada puede ser colocada en la posición actual
-   if (canPlacePiece(new Piece(rotated, piece->x, piece->y), 0, 0)) {
-      piece->shape = rotated;    // Actualiza la forma de la pieza
-   } else {
-      // Intenta ajustar la posición de la pieza rotada si no cabe
-      piece->x = canPlacePiece(new Piece(rotated, piece->x - 1, piece->y), 0, 0) ? piece->x - 1 : canPlacePiece(new Piece(rotated, piece->x + 1, piece->y), 0, 0) ? piece->x + 1 : piece->x;                                                                                                                                                              
-      piece->shape = canPlacePiece(new Piece(rotated, piece->x, piece->y), 0, 0) ? rotated : piece->shape;     // Mantiene la forma original si no se puede rotar
+   if (error) {
+      cerr << "No se pudo leer " << path << ": " << error.message() << "\n";
+      return 1;
    }
+   sort(files.begin(), files.end());
+   ThreadPool pool(threads);
+   vector<char> passed(files.size(), 0);
+   atomic<uint64_t> ticks(0);
+   auto start = chrono::steady_clock::now();
+   pool.parallelFor(files.size(), [&](int i) {
+      MappedFile file(files[i].c_str());
+      ReplayResult result = file.ok() ? playReplay(file.data(), file.size()) : ReplayResult();
+      passed[i] = file.ok() && !result.error && result.matches;
+      ticks += result.ticks;
+   });
+   double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+   int failures = 0;
+   for (size_t i = 0; i < files.size(); ++i) {
+      if (!passed[i]) {
+         cout << "FALLA: " << files[i] << "\n";
+         failures++;
+      }
+   }
+   cout << files.size() << " repeticiones, " << failures << " fallas, " << seconds * 1000 << " ms, "
+        << (seconds > 0 ? files.size() / seconds : 0) << " partidas/s, "
+        << (seconds > 0 ? ticks / seconds / 1e6 : 0) << " M ticks/s (" << pool.size() << " hilos)\n";
+   return failures ? 1 : 0;
 }
 
-char getKeyPress() {    // Obtiene la tecla presionada por el usuario
+int runAllocationCheck(int ticks) {   // Juega sin interfaz con acciones aleatorias y cuenta las reservas tras la preparación
+   if (!ALLOCATION_COUNTING) {
+      cerr << "Compilar con -DTETRIS_CONTAR_ASIGNACIONES para contar reservas\n";
+      return 1;
+   }
 #ifdef _WIN32
-   return _getch();     // Captura la tecla en Windows
+   TerminalRenderer renderer;
 #else
-   struct termios oldt, newt;    // Configuración para capturar teclas en Linux/Unix
-   char ch;
-   tcgetattr(STDIN_FILENO, &oldt);
-   newt = oldt;
-   newt.lflag &= ~(ICANON | ECHO);     // Desactiva el modo canónico y el eco
-   tcsetattr(STDIN_FILENO, TCSANOW, &newt);
-   ch = getchar();      // Captura la tecla
-   tcsetattr(STDIN_FILENO, TCSANOW, &oldt);     // Restaura la configuración anterior
-   return ch;
+   int sink = open("/dev/null", O_WRONLY);
+   TerminalRenderer renderer(sink);                      // Cuadros completos que no se muestran
+#endif
+   GameState game(1, MAX_PIEZAS_PREVIAS);
+   ReplayRecorder recorder(1);
+   mt19937 rng(7);
+   AllocationStats allocations;
+   uint64_t games = 1;
+   for (int t = 0; t < ticks; ++t) {
+      uint64_t allocated = allocationCount();
+      Action action = static_cast<Action>(rng() % TOGGLE_PAUSE);   // Sin pausas
+      applyRecorded(game, recorder, action);
+      game.advance();
+      if (game.gameOver) {
+         uint64_t seed = rng();
+         game.reset(seed);                       // Partidas consecutivas en el mismo estado
+         recorder.restart(seed);                 // El tick vuelve a 0: la grabación también
+         games++;
+      }
+#ifndef _WIN32
+      renderer.render(game);                     // En Windows saldría por la consola
+#endif
+      allocations.frame(allocationCount() - allocated);
+   }
+#ifndef _WIN32
+   close(sink);
 #endif
+   cout << ticks << " ticks, " << games << " partidas, " << game.piecesPlaced << " piezas en la última: "
+        << allocations.total << " reservas (" << allocations.framesWithAllocations << " cuadros, máx. "
+        << allocations.maxPerFrame << " por cuadro)\n";
+   return allocations.total ? 1 : 0;
 }
 
-void handleInput(Piece *activePiece, bool &isPaused) {      // Procesa los comandos del jugador
-   if (_kbhit()) {                                          // Verifica si hay una tecla presionada
-      int key = getch();;                                   // Obtiene la tecla presionada
-      if (key == 0 || key == 224) {                         // Verifica si la tecla es una tecla de función
-         int arrowKey = getch();                            // Obtiene la tecla de flecha
-         if (!isPaused) {                                                     // Si el juego no está en pausa
-            if (arrowKey == 75 && canPlacePiece(activePiece, -1, 0)) {        // Flecha izquierda
-            activePiece->x--;                                                 // Mueve la pieza a la izquierda
-            } else if (arrowKey == 77 && canPlacePiece(activePiece, 1, 0)) {  // Flecha derecha 
-            activePiece->x++;                                                 // Mueve la pieza a la derecha
-            } else if (arrowKey == 80 && canPlacePiece(activePiece, 0, 1)) {  // Flecha abajo
-            activePiece->y++;                                                 // Mueve la pieza hacia abajo
-            } else if (arrowKey == 72) {                                      // Flecha arriba (rotar la pieza)
-            rotatePiece(activePiece);                                         // Rota la pieza
+int runBoardBenchmark(int games) {   // Partidas aleatorias: compara las métricas incrementales con un recálculo completo tras cada pieza
+   mt19937 rng(2024);                                    // Partidas fijas para poder comparar entre ejecuciones
+   MoveGenerator generator;
+   vector<Placement> placements;
+   vector<vector<Piece>> sequences(games);               // Colocaciones de cada partida para la medición
+   EvalWeights weights;
+   uint64_t locks = 0, lines = 0, mismatches = 0;
+   for (int g = 0; g < games; ++g) {
+      Board board;
+      for (int n = 0; n < 1000; ++n) {
+         generator.generate(board, static_cast<Tetromino>(rng() % NUM_TETROMINOS), placements);
+         if (placements.empty()) {
+            break;                                       // Fin de la partida
+         }
+         size_t pick = rng() % placements.size();        // Mezcla jugadas al azar (dejan huecos) con la mejor según la evaluación
+         if (rng() % 8) {
+            double best = -1e18;
+            for (size_t k = 0; k < placements.size(); ++k) {
+               Board next = board;
+               next.placePiece(placements[k].piece);
+               int cleared = next.clearFullLines();
+               double score = evaluateBoard(next, cleared, weights);
+               if (score > best) {
+                  best = score;
+                  pick = k;
+               }
             }
          }
-      } else if (key == 'p' || key == 'P') {    // Pausar/reanudar
-         isPaused = !isPaused;                  // Cambia el estado de pausa  
-         } else if (!isPaused) {                // Si el juego no está en pausa
-            if (key == 'a' && canPlacePiece(activePiece, -1, 0)) {            // 'a' para mover izquierda   
-               activePiece->x--;
-         } else if (key == 'd' && canPlacePiece(activePiece, 1, 0)) {         // 'd' para mover derecha
-            activePiece->x++;
-         } else if (key == 's' && canPlacePiece(activePiece, 0, 1)) {         // 's' para bajar
-            activePiece->y++;
-         } else if (key == 'w') {                                             // 'w' para rotar
-            rotatePiece(activePiece);
-         } else if (key == ' ') {                                             // Barra espaciadora para colocar la pieza
-            while (canPlacePiece(activePiece, 0, 1)) {
-               activePiece->y++;                                              // Coloca la pieza en la parte más baja posible
+         board.placePiece(placements[pick].piece);
+         lines += board.clearFullLines();
+         sequences[g].push_back(placements[pick].piece);
+         locks++;
+
+         BoardFeatures scanned = scanFeatures(board), incremental = computeFeatures(board);
+         uint64_t hash = 0;
+         bool same = true;
+         for (int y = 0; y < HEIGHT; ++y) {
+            hash ^= rowHash(y, board.rows[y]);
+         }
+         for (int x = 0; x < WIDTH; ++x) {
+            int top = 0, cells = 0;
+            while (top < HEIGHT && !board.cell(x, top)) {
+               ++top;
+            }
+            for (int y = 0; y < HEIGHT; ++y) {
+               cells += board.cell(x, y) ? 1 : 0;
             }
+            same = same && board.columnHeights[x] == HEIGHT - top && board.columnCells[x] == cells;
+         }
+         same = same && hash == board.hash && scanned.aggregateHeight == incremental.aggregateHeight
+                && scanned.holes == incremental.holes && scanned.bumpiness == incremental.bumpiness && scanned.wells == incremental.wells;
+         mismatches += same ? 0 : 1;
+      }
+   }
+   cout << games << " partidas, " << locks << " piezas, " << lines << " líneas: "
+        << (mismatches ? to_string(mismatches) + " tableros con métricas distintas" : string("métricas idénticas al recálculo")) << "\n";
+
+   int rounds = 20;
+   uint64_t checksum = 0;
+   auto start = chrono::steady_clock::now();
+   for (int r = 0; r < rounds; ++r) {
+      for (const vector<Piece> &sequence : sequences) {
+         Board board;
+         for (const Piece &piece : sequence) {
+            board.placePiece(piece);
+            checksum += board.clearFullLines();
          }
+         checksum += board.hash;
       }
    }
+   double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+   double lockNs = seconds * 1e9 / (double(locks) * rounds);
+   vector<Board> samples;                                // Tableros de media partida para medir la lectura de métricas
+   for (const vector<Piece> &sequence : sequences) {
+      Board board;
+      for (size_t k = 0; k < sequence.size() / 2; ++k) {
+         board.placePiece(sequence[k]);
+         board.clearFullLines();
+      }
+      samples.push_back(board);
+   }
+   const int READS = 1000000;
+   start = chrono::steady_clock::now();
+   for (int k = 0; k < READS; ++k) {
+      BoardFeatures features = scanFeatures(samples[k % samples.size()]);
+      checksum += features.holes + features.bumpiness;
+   }
+   double scanNs = chrono::duration<double>(chrono::steady_clock::now() - start).count() * 1e9 / READS;
+   start = chrono::steady_clock::now();
+   for (int k = 0; k < READS; ++k) {
+      BoardFeatures features = computeFeatures(samples[k % samples.size()]);
+      checksum += features.holes + features.bumpiness;
+   }
+   double readNs = chrono::duration<double>(chrono::steady_clock::now() - start).count() * 1e9 / READS;
+   cout << "colocar + limpiar: " << lockNs << " ns/pieza (" << 1e3 / lockNs << " M piezas/s)\n"
+        << "métricas: " << readNs << " ns incrementales, " << scanNs << " ns recorriendo el tablero (control " << checksum % 10 << ")\n";
+   return mismatches ? 1 : 0;
 }
 
-void gameLoop() {    // Bucle principal del juego                                     
-   cout << "\033[?25l";                               // Oculta el cursor
-   Piece *activePiece = createRandomPiece();          // Crea la pieza activa
-   upcomingPieces.push(createRandomPiece());          // Agrega una nueva pieza a la cola
-   Piece *nextPiece = upcomingPieces.front();         // Obtiene la próxima pieza
-   upcomingPieces.pop();                              // Elimina la próxima pieza de la cola
-   bool gameOver = false, isPaused = false;           // Estado del juego
-   auto lastDropTime = chrono::steady_clock::now();   // Tiempo de la última caída
-
-   while (!gameOver) {     // Bucle del juego
-      renderGame(activePiece, nextPiece, isPaused);  // Renderiza el estado del juego    
-      handleInput(activePiece, isPaused);            // Llama a la función handleInput para manejar la entrada del usuario
-
-      if (!isPaused && chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - lastDropTime).count() >= speed) {
-         if (canPlacePiece(activePiece, 0, 1)) {         // Mueve la pieza hacia abajo
-            activePiece->y++;
-         } else {
-            placePiece(activePiece);                     // Coloca la pieza en el tablero
-            clearFullLines();                            // Limpia las líneas completas
-            delete activePiece;                          // Libera la memoria de la pieza activa
-            activePiece = nextPiece;                     // La próxima pieza se convierte en la activa
-            if (upcomingPieces.empty()) {
-               upcomingPieces.push(createRandomPiece()); // Agrega una nueva pieza si la cola está vacía   
-            }
-            nextPiece = upcomingPieces.front();          // Obtiene la nueva próxima pieza
-            upcomingPieces.pop();                        // Elimina la próxima pieza de la cola
-            if (!canPlacePiece(activePiece, 0, 0)) {
-               gameOver = true;                          // Termina el juego si no se puede colocar la pieza
+int runTrainer(const char *checkpoint, int generations, const TrainerConfig &config) {   // Algoritmo genético sobre partidas sin interfaz repartidas entre todos los núcleos
+   ThreadPool pool;
+   WeightTrainer trainer(pool, config);
+   if (filesystem::exists(checkpoint)) {
+      if (!trainer.load(checkpoint)) {
+         cerr << "Punto de control no válido: " << checkpoint << "\n";
+         return 1;
+      }
+      cout << "Reanudando desde " << checkpoint << " en la generación " << trainer.generation << "\n";
+   } else {
+      trainer.initialize();
+   }
+   const TrainerConfig &settings = trainer.settings();
+   cout << "Población " << settings.population << ", " << settings.games << " partidas por individuo de hasta "
+        << settings.maxPieces << " piezas, " << pool.size() << " hilos\n";
+   auto start = chrono::steady_clock::now();
+   uint64_t gamesAtStart = trainer.gamesPlayed;
+   int last = trainer.generation + generations;
+   while (trainer.generation < last && !gameCancelled) {
+      auto generationStart = chrono::steady_clock::now();
+      trainer.evaluate();
+      double seconds = chrono::duration<double>(chrono::steady_clock::now() - generationStart).count();
+      const Individual &best = trainer.best();
+      int games = settings.population * settings.games;
+      cout << "Generación " << trainer.generation << ": mejor " << best.fitness << " líneas/partida, "
+           << uint64_t(games / seconds) << " partidas/s, " << 3600 / seconds << " generaciones/hora, pesos ";
+      for (int w = 0; w < NUM_PESOS; ++w) {
+         cout << (w ? "," : "") << best.weights[w];
+      }
+      cout << endl;
+      trainer.evolve();
+      if (!trainer.save(checkpoint)) {
+         cerr << "No se pudo escribir el punto de control " << checkpoint << "\n";
+         return 1;
+      }
+   }
+   double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+   uint64_t played = trainer.gamesPlayed - gamesAtStart;
+   cout << played << " partidas en " << seconds << " s (" << uint64_t(played / max(seconds, 1e-9)) << " partidas/s); punto de control en " << checkpoint << "\n";
+   return 0;
+}
+
+int runSolver(const char *boardPath, const char *sequence, int height, unsigned threads) {   // El tablero es un archivo de filas con '#' (ocupada) y '.' (vacía), alineado abajo
+   using SolverBoard = BasicBoard<SolverGeometry>;
+   const int SOLVER_HEIGHT = SolverGeometry::HEIGHT;
+   if (height < 1 || height > MAX_ALTURA_SOLUCION) {
+      cerr << "La altura debe estar entre 1 y " << MAX_ALTURA_SOLUCION << "\n";
+      return 1;
+   }
+   SolverBoard board;
+   if (string(boardPath) != "vacio") {
+      ifstream in(boardPath);
+      vector<string> lines;
+      for (string line; getline(in, line);) {
+         if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+         }
+         if (!line.empty()) {
+            lines.push_back(line);
+         }
+      }
+      if (!in.eof() || lines.empty() || (int)lines.size() > height) {
+         cerr << "Tablero no válido o más alto que " << height << " filas: " << boardPath << "\n";
+         return 1;
+      }
+      for (size_t r = 0; r < lines.size(); ++r) {
+         int y = SOLVER_HEIGHT - int(lines.size()) + int(r);
+         for (int x = 0; x < WIDTH && x < (int)lines[r].size(); ++x) {
+            if (lines[r][x] == '#') {
+               board.fillCell(x, y);
             }
          }
-         lastDropTime = chrono::steady_clock::now();     // Actualiza el tiempo de la última caída
       }
-
-      if (gameCancelled) {
-         gameOver = true;                                // Termina el juego si se cancela
+      board.clearFullLines();                    // Por si el archivo trae filas completas
+   }
+   const string LETRAS = "IOTLJSZ";              // Mismo orden que Tetromino
+   vector<Tetromino> pieces;
+   for (const char *c = sequence; *c; ++c) {
+      size_t type = LETRAS.find(char(toupper(*c)));
+      if (type == string::npos) {
+         cerr << "Pieza desconocida: " << *c << " (usar " << LETRAS << ")\n";
+         return 1;
       }
+      pieces.push_back(static_cast<Tetromino>(type));
+   }
+   if (pieces.empty() || (int)pieces.size() > MAX_PIEZAS_SOLUCION) {
+      cerr << "La secuencia debe tener entre 1 y " << MAX_PIEZAS_SOLUCION << " piezas\n";
+      return 1;
+   }
 
-      this_thread::sleep_for(chrono::milliseconds(10));  // Pausa breve para evitar el uso excesivo de CPU
+   ThreadPool pool(threads);
+   TranspositionTable table(64);
+   PerfectClearSolver solver(pool, table);
+   cout << "Buscando con " << pieces.size() << " piezas, altura " << height << ", " << pool.size() << " hilos\n";
+   SolverResult result = solver.solve(board, pieces.data(), int(pieces.size()), height,
+      [&](const SolverStats &stats, SolverMode mode, int bestLines) {
+         if (gameCancelled) {
+            solver.cancel();
+         }
+         cout << (mode == SOLVE_CLEAR ? "[perfect clear] " : "[líneas] ") << stats.nodes << " nodos, "
+              << stats.nodesPerSecond() / 1e6 << " M nodos/s, " << stats.pruneRate() * 100 << "% podado";
+         if (mode == SOLVE_LINES && bestLines >= 0) {
+            cout << ", mejor " << bestLines << " líneas";
+         }
+         cout << endl;
+      });
+
+   const SolverStats &stats = result.stats;
+   if (result.perfectClear) {
+      cout << "Perfect clear con " << result.pieces << " piezas (" << result.lines << " líneas):\n";
+   } else {
+      cout << (gameCancelled ? "Búsqueda cancelada; " : "Sin perfect clear; ") << "máximo " << result.lines
+           << " líneas con " << result.pieces << " piezas:\n";
    }
+   for (int k = 0; k < result.pieces; ++k) {
+      const Piece &piece = result.moves[k];
+      cout << "   " << k + 1 << ". " << LETRAS[piece.type] << " rotación " << piece.rotation << ", x " << piece.x
+           << ", y " << piece.y + HEIGHT - SOLVER_HEIGHT << "\n";   // Coordenadas del tablero de juego
+   }
+   cout << stats.nodes << " nodos en " << stats.seconds << " s (" << stats.nodesPerSecond() / 1e6 << " M nodos/s, "
+        << pool.size() << " hilos)\n";
+   cout << "Poda: " << stats.considered << " colocaciones, " << stats.prunedHeight << " por altura, " << stats.prunedParity
+        << " por paridad, " << stats.duplicates << " posiciones repetidas (" << stats.pruneRate() * 100 << "%)\n";
+   return 0;
+}
 
-   displayGameOver();                                    // Muestra el mensaje de Game Over
-   freePieceMemory(activePiece, nextPiece);              // Libera la memoria de las piezas
+#ifdef __linux__
+int runServer(const char *address, unsigned reactors, double seconds) {   // Sirve partidas hasta Ctrl + C o el tiempo dado e informa la capacidad por núcleo
+   SocketAddress where;
+   if (!parseAddress(address, where)) {
+      cerr << "Dirección no válida: " << address << " (unix:/ruta, host:puerto o puerto)\n";
+      return 2;
+   }
+   raiseFileLimit();
+   int listenFd = openSocket(where, true);
+   if (listenFd < 0) {
+      cerr << "No se pudo escuchar en " << address << ": " << strerror(errno) << "\n";
+      return 1;
+   }
+   GameServer server(listenFd, reactors);
+   cout << "Escuchando en " << address << " con " << server.reactors() << " reactores (tick de " << TICK_MS << " ms)\n";
+   double cpuStart = cpuSeconds();
+   auto start = chrono::steady_clock::now();
+   ServerStats stats = server.run(gameCancelled, seconds);
+   double wall = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+   double cpu = cpuSeconds() - cpuStart;
+   close(listenFd);
+   if (where.unixSocket) {
+      unlink(where.path.c_str());
+   }
+   double cores = cpu / max(wall, 1e-9);                 // Núcleos ocupados en promedio
+   cout << "Conexiones: " << stats.accepted << " (máximo simultáneo " << stats.peakSessions << ")\n"
+        << "Ticks de sesión: " << stats.ticks << ", cuadros enviados: " << stats.frames << " (" << stats.bytesOut / max<uint64_t>(stats.frames, 1)
+        << " bytes de media), acciones: " << stats.actions << ", partidas terminadas: " << stats.gamesOver << "\n"
+        << "Ticks con retraso acumulado: " << stats.lateTicks << "\n"
+        << "CPU: " << cpu << " s en " << wall << " s (" << cores * 100 << "% de un núcleo)";
+   if (stats.peakSessions && cores > 0) {
+      cout << ", " << uint64_t(stats.peakSessions / cores) << " sesiones por núcleo a plena carga";
+   }
+   cout << "\n";
+   stats.jitter.print(cout, "Retraso del tick del servidor");
+   return 0;
 }
 
-void freePieceMemory(Piece *activePiece, Piece *nextPiece) {   // Libera la memoria de las piezas activas
-   delete activePiece;     // Libera la pieza activa
-   delete nextPiece;       // Libera la próxima pieza
+int runLoadGenerator(const char *address, int sessions, double seconds, double actionsPerSecond) {   // Carga el servidor por loopback y mide la latencia acción -> confirmación
+   SocketAddress where;
+   if (!parseAddress(address, where)) {
+      cerr << "Dirección no válida: " << address << "\n";
+      return 2;
+   }
+   raiseFileLimit();
+   LoadGenerator generator;
+   auto start = chrono::steady_clock::now();
+   LoadStats stats = generator.run(where, sessions, seconds, actionsPerSecond, gameCancelled);
+   double wall = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+   cout << "Sesiones: " << stats.sessions << " (" << stats.connectFailures << " fallidas, " << stats.disconnects << " cerradas por el servidor)\n"
+        << "Acciones: " << stats.actionsSent << " enviadas, " << stats.acks << " confirmadas (" << uint64_t(stats.acks / wall) << "/s)\n"
+        << "Cuadros: " << stats.frames << " (" << uint64_t(stats.frames / wall) << "/s, " << stats.bytesIn / wall / 1e6 << " MB/s), partidas terminadas: " << stats.gamesOver << "\n";
+   stats.latency.print(cout, "Latencia acción -> confirmación");
+   return stats.sessions && stats.acks ? 0 : 1;
 }
+#endif
 
-void displayGameOver() {   // Muestra el mensaje de Game Over
+template <typename G>
+void displayGameOver(const BasicGameState<G> &game) {   // Muestra el mensaje de Game Over
    cout << "\033[2J\033[H"
         << "|====================|\n"
         << "|    FIN DEL JUEGO   |\n"
         << "|====================|\n\n"
-        << "Puntaje final: " << score << "\n";  // Muestra el puntaje final
+        << "Puntaje final: " << game.score << "\n";  // Muestra el puntaje final
 }
 
 void signalHandler(int signum) {    // Maneja señales como SIGINT
@@ -0,0 +1,266 @@
+// Renderizador de terminal con doble buffer de celdas.
+// Cada cuadro se compone en el buffer trasero, se compara celda por celda con lo
+// que ya está en pantalla y solo se envían los tramos que cambiaron, con el
+// mínimo de movimientos de cursor, en una única llamada a write(2). Toda la
+// memoria se reserva al construir el renderizador.
+#ifndef TETRIS_RENDER_H
+#define TETRIS_RENDER_H
+
+#include <vector>       // Buffers de celdas y de salida (reservados una sola vez)
+#include <chrono>       // Tiempo de renderizado por cuadro
+#include <cstdint>      // Tipos enteros de tamaño fijo
+#include <algorithm>    // fill(), max()
+
+#ifdef _WIN32
+#include <windows.h>    // WriteFile() en Windows
+#else
+#include <unistd.h>     // write() en Linux/Unix
+#include <poll.h>       // Espera a que la terminal acepte más datos
+#include <cerrno>       // EAGAIN, EINTR
+#endif
+
+#include "tetrisCore.h"  // Estado de la partida
+
+// Estadísticas del renderizador
+struct RenderStats {
+   uint64_t frames = 0;          // Cuadros solicitados
+   uint64_t skippedFrames = 0;   // Cuadros sin cambios (no se escribió nada)
+   uint64_t bytes = 0;           // Bytes enviados a la terminal
+   uint64_t totalNs = 0;         // Tiempo total de composición y escritura
+   uint64_t maxNs = 0;           // Peor cuadro
+
+   double bytesPerFrame() const { return frames ? double(bytes) / frames : 0; }
+   double averageUs() const { return frames ? totalNs / 1000.0 / frames : 0; }
+};
+
+template <typename G>
+class BasicTerminalRenderer {
+public:
+   static constexpr int VISIBLE = G::VISIBLE;                 // Filas visibles del tablero
+   static constexpr int HIDDEN = G::HEIGHT - G::VISIBLE;      // Filas de la zona de reserva (no se dibujan)
+   static constexpr int ROWS = VISIBLE + 10;                  // Filas de la pantalla
+   static constexpr int COLS = G::WIDTH * 2 + 4 + 40;         // Tablero con bordes y columna de información
+   static constexpr int MAX_GAP = 6;                          // Celdas sin cambios que conviene reescribir antes que mover el cursor
+
+#ifdef _WIN32
+   BasicTerminalRenderer() : front(ROWS * COLS, U' '), back(ROWS * COLS, ' '), output(ROWS * (COLS * 4 + COLS * 8) + 64) {}
+#else
+   explicit BasicTerminalRenderer(int fd = STDOUT_FILENO) : fd(fd), front(ROWS * COLS, U' '), back(ROWS * COLS, ' '), output(ROWS * (COLS * 4 + COLS * 8) + 64) {}
+#endif
+
+   void render(const BasicGameState<G> &game) {   // Compone el cuadro y envía solo las diferencias
+      auto start = std::chrono::steady_clock::now();
+      compose(game);
+      size_t bytes = diff();
+      if (bytes == 0) {
+         stats.skippedFrames++;     // Nada cambió desde el cuadro anterior
+      } else {
+         writeAll(output.data(), bytes);
+         stats.bytes += bytes;
+      }
+      uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+      stats.frames++;
+      stats.totalNs += ns;
+      stats.maxNs = std::max(stats.maxNs, ns);
+   }
+
+   void invalidate() {   // Fuerza a redibujar toda la pantalla en el próximo cuadro
+      std::fill(front.begin(), front.end(), 0);
+   }
+
+   RenderStats stats;
+
+private:
+#ifndef _WIN32
+   int fd;                            // Descriptor de salida
+#endif
+   std::vector<char32_t> front;       // Lo que hay en la terminal (se asume limpia al empezar; 0 = desconocido)
+   std::vector<char32_t> back;        // Cuadro que se está componiendo
+   std::vector<char> output;          // Secuencias de escape del cuadro
+   size_t length = 0;                 // Bytes usados de 'output'
+
+   // --- Composición ---
+
+   int put(int row, int col, const char *text) {   // Escribe texto UTF-8 en el buffer trasero; retorna la columna siguiente
+      const unsigned char *p = reinterpret_cast<const unsigned char *>(text);
+      while (*p && col < COLS) {
+         char32_t code = *p++;
+         if (code >= 0xC0) {     // Decodifica secuencias de varios bytes
+            int extra = code >= 0xF0 ? 3 : code >= 0xE0 ? 2 : 1;
+            code &= 0x3F >> extra;
+            for (int k = 0; k < extra && (*p & 0xC0) == 0x80; ++k) {
+               code = code << 6 | (*p++ & 0x3F);
+            }
+         }
+         back[row * COLS + col++] = code;
+      }
+      return col;
+   }
+
+   int putNumber(int row, int col, int value) {   // Escribe un número sin crear cadenas
+      char digits[12];
+      int n = 0;
+      unsigned magnitude = value < 0 ? -unsigned(value) : unsigned(value);
+      do {
+         digits[n++] = char('0' + magnitude % 10);
+         magnitude /= 10;
+      } while (magnitude);
+      if (value < 0) {
+         digits[n++] = '-';
+      }
+      while (n > 0 && col < COLS) {
+         back[row * COLS + col++] = digits[--n];
+      }
+      return col;
+   }
+
+   void compose(const BasicGameState<G> &game) {   // Construye el cuadro completo en el buffer trasero
+      static const char *controls[] = {"     W: Rotar", "     A: Mover a la izquierda", "     D: Mover a la derecha", "     S: Caída rápida", "     ESPACIO: Caída instantánea", "     P: Pausar/Reanudar"};
+      std::fill(back.begin(), back.end(), U' ');
+      const Piece &activePiece = game.activePiece, &nextPiece = game.nextPiece();
+      for (int i = 0; i < VISIBLE; ++i) {  // Construcción visual del tablero (filas)
+         int col = put(i, 0, "<|");
+         int y = i + HIDDEN;               // Fila del tablero que se dibuja en la fila i de la pantalla
+         int pi = y - activePiece.y;       // Fila de la pieza que cae en esa fila del tablero
+         uint64_t pieceRow = pi >= 0 && pi < MAX_FILAS_PIEZA ? shiftRow(activePiece.rows()[pi], activePiece.x) : 0;
+         for (int j = 0; j < G::WIDTH; ++j) {
+            col = put(i, col, ((pieceRow >> j & 1) || game.board.cell(j, y)) ? "[]" : "..");
+         }
+         col = put(i, col, "|>");
+         if (i == 1) {
+            putNumber(i, put(i, col, "   Puntaje: "), game.score);                  // Muestra el puntaje
+         } else if (i == 2) {
+            putNumber(i, put(i, col, "   Líneas eliminadas: "), game.linesCleared); // Muestra líneas eliminadas
+         } else if (i == 3) {
+            putNumber(i, put(i, col, "   Nivel: "), game.level);                    // Muestra el nivel
+         } else if (i == 5) {
+            put(i, col, "   Próxima pieza:");                                       // Indica la próxima pieza
+         } else if (i >= 6 && i < 6 + MAX_FILAS_PIEZA) {                            // Renderiza la próxima pieza
+            col = put(i, col, "   ");
+            for (int pj = 0; pj < 4; ++pj) {
+               col = put(i, col, (nextPiece.rows()[i - 6] >> pj & 1) ? "[]" : "  ");
+            }
+         } else if (i == 10 && game.upcomingPieces.size() > 1) {                    // Resto de la vista previa por letra
+            col = put(i, col, "   Luego:");
+            for (int k = 1; k < game.upcomingPieces.size(); ++k) {
+               char name[] = {' ', "IOTLJSZ"[game.upcomingPieces[k].type], 0};
+               col = put(i, col, name);
+            }
+         } else if (i == 11) {
+            put(i, col, "   Controles:");
+         } else if (i >= 12 && i <= 17) {                                            // Muestra los controles
+            put(i, col, controls[i - 12]);
+         }
+      }
+      int col = put(VISIBLE, 0, "<|");
+      for (int j = 0; j < G::WIDTH * 2; ++j) {
+         col = put(VISIBLE, col, "=");
+      }
+      put(VISIBLE, col, "|>");
+      if (game.isPaused) {      // Si el juego está en pausa
+         put(VISIBLE + 2, 0, " |====================|");
+         put(VISIBLE + 3, 0, " |  JUEGO EN PAUSA    |");
+         put(VISIBLE + 4, 0, " |====================|");
+      }
+   }
+
+   // --- Diferencias y salida ---
+
+   void append(const char *text, size_t n) {
+      std::copy(text, text + n, output.begin() + length);
+      length += n;
+   }
+
+   void appendNumber(int value) {
+      char digits[12];
+      int n = 0;
+      do {
+         digits[n++] = char('0' + value % 10);
+         value /= 10;
+      } while (value);
+      while (n > 0) {
+         output[length++] = digits[--n];
+      }
+   }
+
+   void appendCell(char32_t code) {   // Codifica la celda en UTF-8
+      if (code < 0x80) {
+         output[length++] = char(code);
+      } else if (code < 0x800) {
+         output[length++] = char(0xC0 | code >> 6);
+         output[length++] = char(0x80 | (code & 0x3F));
+      } else if (code < 0x10000) {
+         output[length++] = char(0xE0 | code >> 12);
+         output[length++] = char(0x80 | (code >> 6 & 0x3F));
+         output[length++] = char(0x80 | (code & 0x3F));
+      } else {
+         output[length++] = char(0xF0 | code >> 18);
+         output[length++] = char(0x80 | (code >> 12 & 0x3F));
+         output[length++] = char(0x80 | (code >> 6 & 0x3F));
+         output[length++] = char(0x80 | (code & 0x3F));
+      }
+   }
+
+   size_t diff() {   // Genera las secuencias para pasar de 'front' a 'back'; retorna los bytes generados
+      length = 0;
+      int cursorRow = -1, cursorCol = -1;     // Posición conocida del cursor tras la última escritura
+      for (int row = 0; row < ROWS; ++row) {
+         const char32_t *now = &back[row * COLS];
+         char32_t *shown = &front[row * COLS];
+         int col = 0;
+         while (col < COLS) {
+            if (now[col] == shown[col]) {
+               ++col;
+               continue;
+            }
+            int end = col + 1, last = col;     // Extiende el tramo mientras los huecos sin cambios sean cortos
+            while (end < COLS && end - last <= MAX_GAP) {
+               if (now[end] != shown[end]) {
+                  last = end;
+               }
+               ++end;
+            }
+            if (cursorRow != row || cursorCol != col) {
+               append("\033[", 2);
+               appendNumber(row + 1);
+               output[length++] = ';';
+               appendNumber(col + 1);
+               output[length++] = 'H';
+            }
+            for (int c = col; c <= last; ++c) {
+               appendCell(now[c]);
+               shown[c] = now[c];
+            }
+            cursorRow = row;
+            cursorCol = last + 1;
+            col = last + 1;
+         }
+      }
+      return length;
+   }
+
+   void writeAll(const char *data, size_t size) {   // Envía el cuadro completo con una sola llamada al sistema
+#ifdef _WIN32
+      DWORD written = 0;
+      WriteFile(GetStdHandle(STD_OUTPUT_HANDLE), data, DWORD(size), &written, nullptr);
+#else
+      while (size > 0) {
+         ssize_t written = ::write(fd, data, size);
+         if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+            pollfd out = {fd, POLLOUT, 0};
+            poll(&out, 1, -1);   // Salida no bloqueante llena: el cuadro ya está en front[], no se puede descartar
+            continue;
+         }
+         if (written <= 0) {
+            return;     // La terminal se cerró: se descarta el cuadro
+         }
+         data += written;
+         size -= written;
+      }
+#endif
+   }
+};
+
+using TerminalRenderer = BasicTerminalRenderer<StandardGeometry>;
+
+#endif
@@ -0,0 +1,228 @@
+// Repeticiones binarias compactas de una partida.
+// Formato (enteros en little endian):
+//   cabecera: "TTR" 3 (versión) | semilla (u64) | geometría del tablero (u8; la versión 1 no la tiene y es 10x20)
+//   (las versiones 1 y 2 se grabaron cuando el generador usaba solo los 32 bits bajos de la semilla)
+//   registros: un varint por acción con (ticks desde la acción anterior << 3 | acción)
+//   pie: tick final (u64) | puntaje (u32) | líneas (u32) | piezas (u32) | hash del tablero (u64)
+//        | acciones (u32) | fin del juego (u8) | "TTRF"
+// Como el núcleo es determinista para una semilla, reaplicar las acciones en sus ticks
+// reproduce exactamente la partida, y el pie permite verificarlo.
+#ifndef TETRIS_REPLAY_H
+#define TETRIS_REPLAY_H
+
+#include <vector>       // Buffer de grabación
+#include <cstdint>      // Tipos enteros de tamaño fijo
+#include <cstdio>       // Escritura del archivo
+#include <cstring>      // memcmp()
+
+#ifdef _WIN32
+#include <fstream>      // Lectura completa del archivo en Windows
+#include <iterator>     // istreambuf_iterator
+#else
+#include <sys/mman.h>   // Proyección del archivo en memoria
+#include <sys/stat.h>   // Tamaño del archivo
+#include <fcntl.h>      // open()
+#include <unistd.h>     // close()
+#endif
+
+#include "tetrisCore.h"  // Estado de la partida
+
+const int REPLAY_HEADER_BYTES = 13;
+const int REPLAY_FOOTER_BYTES = 37;
+
+// Graba las acciones de una partida en memoria y las escribe al terminar
+class ReplayRecorder {
+public:
+   explicit ReplayRecorder(uint64_t seed, BoardVariant variant = BOARD_10X20) {
+      data.reserve(1 << 20);     // Suficiente para partidas largas sin reservar memoria durante el juego
+      restart(seed, variant);
+   }
+
+   void restart(uint64_t seed, BoardVariant variant = BOARD_10X20) {   // Empieza otra grabación (tras BasicGameState::reset) sin reservar memoria
+      data.clear();
+      data.insert(data.end(), {'T', 'T', 'R', 3});
+      putU64(seed);
+      data.push_back(uint8_t(variant));
+      lastTick = 0;
+      actions = 0;
+   }
+
+   void record(uint64_t tick, Action action) {   // Anota una acción aplicada en el tick lógico dado (los ticks nunca retroceden dentro de una grabación)
+      uint64_t value = (tick - lastTick) << 3 | action;
+      while (value >= 0x80) {
+         data.push_back(uint8_t(value | 0x80));
+         value >>= 7;
+      }
+      data.push_back(uint8_t(value));
+      lastTick = tick;
+      actions++;
+   }
+
+   template <typename G>
+   bool save(const char *path, const BasicGameState<G> &game) {   // Agrega el pie con el resultado y escribe el archivo
+      size_t body = data.size();
+      putU64(game.tick);
+      putU32(uint32_t(game.score));
+      putU32(uint32_t(game.linesCleared));
+      putU32(uint32_t(game.piecesPlaced));
+      putU64(game.board.hash);
+      putU32(actions);
+      data.push_back(game.gameOver ? 1 : 0);
+      data.insert(data.end(), {'T', 'T', 'R', 'F'});
+      FILE *file = std::fopen(path, "wb");
+      bool ok = file && std::fwrite(data.data(), 1, data.size(), file) == data.size();
+      ok = file && std::fclose(file) == 0 && ok;
+      data.resize(body);     // Permite seguir grabando y guardar de nuevo
+      return ok;
+   }
+
+   uint32_t actions = 0;
+
+private:
+   std::vector<uint8_t> data;
+   uint64_t lastTick = 0;
+
+   void putU32(uint32_t value) {
+      for (int i = 0; i < 4; ++i) {
+         data.push_back(uint8_t(value >> (8 * i)));
+      }
+   }
+
+   void putU64(uint64_t value) {
+      for (int i = 0; i < 8; ++i) {
+         data.push_back(uint8_t(value >> (8 * i)));
+      }
+   }
+};
+
+// Resultado de reproducir una repetición
+struct ReplayResult {
+   const char *error = nullptr;    // Archivo inválido (nullptr si se pudo leer)
+   bool matches = false;           // El resultado coincide con el pie
+   uint64_t seed = 0, ticks = 0, actions = 0;
+   BoardVariant variant = BOARD_10X20;
+   int score = 0, linesCleared = 0;
+   uint64_t boardHash = 0;
+};
+
+inline uint64_t readLE(const uint8_t *p, int bytes) {
+   uint64_t value = 0;
+   for (int i = bytes - 1; i >= 0; --i) {
+      value = value << 8 | p[i];
+   }
+   return value;
+}
+
+// Reaplica los registros sobre una partida nueva de la geometría G y compara el resultado con el pie
+template <typename G>
+void replayRecords(const uint8_t *p, const uint8_t *footer, ReplayResult &result) {
+   BasicGameState<G> game(result.seed);
+   uint64_t tick = 0;
+   while (p < footer) {
+      uint64_t value = 0;
+      int shift = 0;
+      do {
+         if (p == footer || shift > 63) {
+            result.error = "registro truncado";
+            return;
+         }
+         value |= uint64_t(*p & 0x7F) << shift;
+         shift += 7;
+      } while (*p++ & 0x80);
+      tick += value >> 3;
+      while (game.tick < tick && !game.gameOver && !game.isPaused) {
+         game.advance();
+      }
+      game.apply(static_cast<Action>(value & 7));
+      result.actions++;
+   }
+   uint64_t finalTick = readLE(footer, 8);
+   while (game.tick < finalTick && !game.gameOver && !game.isPaused) {
+      game.advance();
+   }
+   result.ticks = game.tick;
+   result.score = game.score;
+   result.linesCleared = game.linesCleared;
+   result.boardHash = game.board.hash;
+   result.matches = game.tick == finalTick
+                 && uint32_t(game.score) == readLE(footer + 8, 4)
+                 && uint32_t(game.linesCleared) == readLE(footer + 12, 4)
+                 && game.piecesPlaced == readLE(footer + 16, 4)
+                 && game.board.hash == readLE(footer + 20, 8)
+                 && result.actions == readLE(footer + 28, 4)
+                 && game.gameOver == (footer[32] != 0);
+}
+
+// Reproduce la partida sin interfaz, tan rápido como se pueda, y la compara con el pie
+inline ReplayResult playReplay(const uint8_t *data, size_t size) {
+   ReplayResult result;
+   int version = size >= 4 && std::memcmp(data, "TTR", 3) == 0 ? data[3] : 0;
+   int header = version == 1 ? REPLAY_HEADER_BYTES - 1 : REPLAY_HEADER_BYTES;
+   if (version < 1 || version > 3 || size < size_t(header + REPLAY_FOOTER_BYTES)
+       || std::memcmp(data + size - 4, "TTRF", 4) != 0 || (version >= 2 && data[12] >= NUM_BOARD_VARIANTS)) {
+      result.error = "formato no reconocido";
+      return result;
+   }
+   result.seed = readLE(data + 4, 8);
+   if (version < 3) {
+      result.seed = uint32_t(result.seed);    // Lo que usaba el generador al grabarla
+   }
+   result.variant = version >= 2 ? static_cast<BoardVariant>(data[12]) : BOARD_10X20;
+   withGeometry(result.variant, [&](auto geometry) {
+      replayRecords<decltype(geometry)>(data + header, data + size - REPLAY_FOOTER_BYTES, result);
+   });
+   return result;
+}
+
+// Archivo de solo lectura proyectado en memoria (leído completo en Windows)
+class MappedFile {
+public:
+   explicit MappedFile(const char *path) {
+#ifdef _WIN32
+      std::ifstream in(path, std::ios::binary);
+      buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+      bytes = reinterpret_cast<const uint8_t *>(buffer.data());
+      length = buffer.size();
+      valid = bool(in) || in.eof();
+#else
+      int fd = open(path, O_RDONLY);
+      struct stat info;
+      if (fd >= 0 && fstat(fd, &info) == 0 && info.st_size > 0) {
+         void *map = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+         if (map != MAP_FAILED) {
+            bytes = static_cast<const uint8_t *>(map);
+            length = info.st_size;
+            valid = true;
+         }
+      }
+      if (fd >= 0) {
+         close(fd);     // La proyección sigue siendo válida sin el descriptor
+      }
+#endif
+   }
+
+   ~MappedFile() {
+#ifndef _WIN32
+      if (valid) {
+         munmap(const_cast<uint8_t *>(bytes), length);
+      }
+#endif
+   }
+
+   MappedFile(const MappedFile &) = delete;
+   MappedFile &operator=(const MappedFile &) = delete;
+
+   const uint8_t *data() const { return bytes; }
+   size_t size() const { return length; }
+   bool ok() const { return valid; }
+
+private:
+   const uint8_t *bytes = nullptr;
+   size_t length = 0;
+   bool valid = false;
+#ifdef _WIN32
+   std::vector<char> buffer;
+#endif
+};
+
+#endif
@@ -0,0 +1,587 @@
+// Servidor de partidas sin interfaz (solo Linux) y generador de carga.
+// Cada núcleo ejecuta un reactor epoll de un solo hilo con su propio temporizador de
+// ticks; todos comparten el socket de escucha (EPOLLEXCLUSIVE reparte las conexiones).
+// Cada conexión es una partida independiente que solo toca su reactor, así que no hay
+// bloqueos: las entradas se aplican al llegar y se confirman de inmediato, y en cada
+// tick se envían solo las diferencias del cuadro en binario.
+//
+// Protocolo (enteros en little endian):
+//   cliente -> servidor, 4 bytes: acción (u8) | reservado (u8) | secuencia (u16)
+//   servidor -> cliente:
+//     MSG_ACK       secuencia (u16)
+//     MSG_FRAME     tick (u32) | banderas (u8) | filas (u8) | filas * (y (u8), máscara (u16))
+//                   [| pieza: tipo (u8), rotación (u8), x (i8), y (i8)] [| puntaje (u32), líneas (u16), nivel (u8)]
+//     MSG_GAME_OVER puntaje (u32); la sesión empieza otra partida enseguida
+#ifndef TETRIS_SERVER_H
+#define TETRIS_SERVER_H
+
+#ifdef __linux__
+
+#include <vector>       // Buffers y sesiones de cada reactor
+#include <string>       // Direcciones
+#include <thread>       // Un reactor por hilo
+#include <atomic>       // Parada de los reactores
+#include <memory>       // Sesiones en memoria estable
+#include <random>       // Semillas de las partidas y acciones del generador
+#include <cstring>      // memcpy(), strerror()
+#include <cerrno>       // EAGAIN, EINTR
+
+#include <sys/epoll.h>      // Reactor
+#include <sys/timerfd.h>    // Ticks del servidor
+#include <sys/socket.h>     // Sockets
+#include <sys/un.h>         // Sockets Unix
+#include <sys/resource.h>   // Límite de descriptores y tiempo de CPU
+#include <netinet/in.h>     // Sockets TCP
+#include <netinet/tcp.h>    // TCP_NODELAY
+#include <arpa/inet.h>      // inet_pton()
+#include <unistd.h>         // close(), read()
+#include <fcntl.h>          // O_NONBLOCK
+
+#include "tetrisCore.h"      // Partidas
+#include "tetrisTerminal.h"  // Reloj monotónico e histogramas de latencia
+
+enum ServerMessage : uint8_t {MSG_ACK = 1, MSG_FRAME = 2, MSG_GAME_OVER = 3};
+const int CLIENT_MESSAGE_BYTES = 4;
+const uint8_t FRAME_PIECE = 1, FRAME_STATS = 2;   // Banderas del cuadro: partes opcionales presentes
+const size_t MAX_OUTPUT_BYTES = 64 * 1024;        // Un cliente que no lee más que esto se desconecta
+
+// Dirección de escucha o conexión: "unix:/ruta", "host:puerto" o solo "puerto" (127.0.0.1)
+struct SocketAddress {
+   bool unixSocket = false;
+   std::string path;                 // Ruta del socket Unix
+   std::string host = "127.0.0.1";
+   int port = 0;
+};
+
+inline bool parseAddress(const std::string &text, SocketAddress &out) {
+   if (text.compare(0, 5, "unix:") == 0) {
+      out.unixSocket = true;
+      out.path = text.substr(5);
+      return !out.path.empty() && out.path.size() < sizeof(sockaddr_un::sun_path);
+   }
+   size_t colon = text.rfind(':');
+   if (colon != std::string::npos) {
+      out.host = text.substr(0, colon);
+   }
+   out.port = std::atoi(text.c_str() + (colon == std::string::npos ? 0 : colon + 1));
+   return out.port > 0 && out.port < 65536;
+}
+
+inline int openSocket(const SocketAddress &address, bool listening) {   // Crea el socket y escucha o se conecta; -1 si falla
+   int fd = socket(address.unixSocket ? AF_UNIX : AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+   if (fd < 0) {
+      return -1;
+   }
+   int ok;
+   if (address.unixSocket) {
+      sockaddr_un addr{};
+      addr.sun_family = AF_UNIX;
+      std::strncpy(addr.sun_path, address.path.c_str(), sizeof(addr.sun_path) - 1);
+      if (listening) {
+         unlink(address.path.c_str());     // Socket de una ejecución anterior
+      }
+      ok = listening ? bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) : connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+   } else {
+      sockaddr_in addr{};
+      addr.sin_family = AF_INET;
+      addr.sin_port = htons(uint16_t(address.port));
+      inet_pton(AF_INET, address.host.c_str(), &addr.sin_addr);
+      int one = 1;
+      setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+      ok = listening ? bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) : connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+      setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));   // Las confirmaciones no esperan a llenar un paquete
+   }
+   if (ok == 0 && listening) {
+      ok = listen(fd, SOMAXCONN);
+   }
+   if (ok != 0) {
+      close(fd);
+      return -1;
+   }
+   fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+   return fd;
+}
+
+inline void raiseFileLimit() {   // Miles de sesiones necesitan miles de descriptores
+   rlimit limit;
+   if (getrlimit(RLIMIT_NOFILE, &limit) == 0) {
+      limit.rlim_cur = limit.rlim_max;
+      setrlimit(RLIMIT_NOFILE, &limit);
+   }
+}
+
+inline double cpuSeconds() {   // Tiempo de CPU del proceso (usuario + sistema)
+   rusage usage;
+   getrusage(RUSAGE_SELF, &usage);
+   return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+// Buffer de salida de una conexión: se envía lo que el socket acepte y el resto espera a EPOLLOUT
+struct OutputBuffer {
+   std::vector<uint8_t> bytes;
+   size_t sent = 0;
+
+   void putU8(uint8_t value) { bytes.push_back(value); }
+   void putU16(uint16_t value) { bytes.push_back(uint8_t(value)); bytes.push_back(uint8_t(value >> 8)); }
+   void putU32(uint32_t value) { putU16(uint16_t(value)); putU16(uint16_t(value >> 16)); }
+
+   bool flush(int fd) {   // Retorna falso si la conexión se perdió
+      while (sent < bytes.size()) {
+         ssize_t n = send(fd, bytes.data() + sent, bytes.size() - sent, MSG_NOSIGNAL);
+         if (n < 0) {
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+         }
+         sent += n;
+      }
+      bytes.clear();
+      sent = 0;
+      return true;
+   }
+
+   bool pending() const { return sent < bytes.size(); }
+};
+
+// Estadísticas de un reactor (se suman al terminar)
+struct ServerStats {
+   uint64_t sessions = 0, peakSessions = 0, accepted = 0;
+   uint64_t ticks = 0, lateTicks = 0;       // Ticks procesados y los que llegaron con más de un vencimiento acumulado
+   uint64_t actions = 0, frames = 0, bytesOut = 0, gamesOver = 0;
+   LatencyHistogram jitter;                 // Retraso del despertar respecto del tick programado
+
+   void merge(const ServerStats &other) {
+      sessions += other.sessions;
+      peakSessions += other.peakSessions;
+      accepted += other.accepted;
+      ticks += other.ticks;
+      lateTicks += other.lateTicks;
+      actions += other.actions;
+      frames += other.frames;
+      bytesOut += other.bytesOut;
+      gamesOver += other.gamesOver;
+      jitter.merge(other.jitter);
+   }
+};
+
+class GameServer {
+public:
+   GameServer(int listenFd, unsigned reactors) : listenFd(listenFd), stats(std::max(1u, reactors)) {}
+
+   // Ejecuta los reactores hasta que 'stop' sea verdadero o pasen 'seconds' (0 = sin límite)
+   ServerStats run(const std::atomic<bool> &stop, double seconds) {
+      uint64_t deadline = seconds > 0 ? monotonicNs() + uint64_t(seconds * 1e9) : ~0ull;
+      std::vector<std::thread> threads;
+      for (size_t r = 0; r < stats.size(); ++r) {
+         threads.emplace_back([this, r, &stop, deadline] { reactorLoop(stats[r], stop, deadline); });
+      }
+      for (std::thread &thread : threads) {
+         thread.join();
+      }
+      ServerStats total;
+      for (const ServerStats &reactor : stats) {
+         total.merge(reactor);
+      }
+      return total;
+   }
+
+   unsigned reactors() const { return stats.size(); }
+
+private:
+   struct Session {
+      int fd;
+      GameState game;
+      std::array<uint16_t, HEIGHT> sentRows{};   // Tablero que el cliente ya conoce
+      Piece sentPiece;
+      bool pieceKnown = false;
+      int sentScore = -1, sentLines = -1, sentLevel = -1;
+      uint8_t input[CLIENT_MESSAGE_BYTES];       // Mensaje parcial recibido
+      int inputLength = 0;
+      OutputBuffer output;
+      bool writing = false;                      // EPOLLOUT activo
+      bool dead = false;                         // Cerrada durante el lote de eventos actual; se elimina al terminarlo
+
+      Session(int fd, uint64_t seed) : fd(fd), game(seed) { output.bytes.reserve(1024); }
+   };
+
+   int listenFd;
+   std::vector<ServerStats> stats;   // Una entrada por reactor
+
+   void reactorLoop(ServerStats &stat, const std::atomic<bool> &stop, uint64_t deadline) {
+      int epoll = epoll_create1(EPOLL_CLOEXEC);
+      int timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+      const uint64_t tickNs = TICK_MS * 1000000ull;
+      uint64_t started = monotonicNs();          // Los ticks se programan en absoluto desde aquí
+      itimerspec period{};
+      period.it_interval.tv_nsec = long(tickNs);
+      period.it_value.tv_sec = (started + tickNs) / 1000000000ull;
+      period.it_value.tv_nsec = (started + tickNs) % 1000000000ull;
+      timerfd_settime(timer, TFD_TIMER_ABSTIME, &period, nullptr);
+      epoll_event event{};
+      event.events = EPOLLIN | EPOLLEXCLUSIVE;   // Solo un reactor despierta por cada conexión nueva
+      event.data.ptr = nullptr;                  // nullptr = socket de escucha
+      epoll_ctl(epoll, EPOLL_CTL_ADD, listenFd, &event);
+      event.events = EPOLLIN;
+      event.data.ptr = &timer;
+      epoll_ctl(epoll, EPOLL_CTL_ADD, timer, &event);
+
+      std::vector<std::unique_ptr<Session>> sessions;
+      std::mt19937_64 seeds(std::random_device{}());
+      epoll_event events[256];
+      uint64_t scheduled = 0;                    // Ticks programados desde el inicio
+      while (!stop && monotonicNs() < deadline) {
+         int n = epoll_wait(epoll, events, 256, 100);
+         for (int e = 0; e < n; ++e) {
+            void *tag = events[e].data.ptr;
+            if (tag == nullptr) {
+               acceptAll(epoll, sessions, seeds, stat);
+            } else if (tag == &timer) {
+               uint64_t expirations = 0;
+               if (read(timer, &expirations, sizeof(expirations)) != sizeof(expirations)) {
+                  continue;
+               }
+               scheduled += expirations;
+               int64_t late = int64_t(monotonicNs() - (started + scheduled * tickNs));
+               stat.jitter.record(late > 0 ? uint64_t(late) : 0);   // Un despertar adelantado cuenta como puntual
+               stat.lateTicks += expirations - 1;
+               for (std::unique_ptr<Session> &session : sessions) {
+                  if (session->dead) {
+                     continue;
+                  }
+                  for (uint64_t k = 0; k < expirations; ++k) {
+                     session->game.advance();
+                  }
+                  sendFrame(*session, stat);
+                  stat.ticks += expirations;
+                  if (!session->output.flush(session->fd) || session->output.bytes.size() > MAX_OUTPUT_BYTES) {
+                     markDead(epoll, *session);
+                  } else {
+                     watchWrites(epoll, *session);
+                  }
+               }
+            } else {
+               Session &session = *static_cast<Session *>(tag);
+               if (session.dead) {
+                  continue;      // Cerrada antes en este mismo lote
+               }
+               bool alive = !(events[e].events & (EPOLLERR | EPOLLHUP));
+               if (alive && (events[e].events & EPOLLIN)) {
+                  alive = readInput(session, stat) && session.output.flush(session.fd);   // Confirmación inmediata
+               }
+               if (alive && (events[e].events & EPOLLOUT)) {
+                  alive = session.output.flush(session.fd);
+               }
+               alive = alive && session.output.bytes.size() <= MAX_OUTPUT_BYTES;   // Envía acciones pero no lee las confirmaciones
+               if (alive) {
+                  watchWrites(epoll, session);
+               } else {
+                  markDead(epoll, session);
+               }
+            }
+         }
+         for (size_t i = sessions.size(); i-- > 0;) {   // Las sesiones se liberan solo cuando ningún evento pendiente las apunta
+            if (sessions[i]->dead) {
+               closeSession(epoll, sessions, i, stat);
+            }
+         }
+      }
+      for (size_t i = sessions.size(); i-- > 0;) {
+         closeSession(epoll, sessions, i, stat);
+      }
+      close(timer);
+      close(epoll);
+   }
+
+   void acceptAll(int epoll, std::vector<std::unique_ptr<Session>> &sessions, std::mt19937_64 &seeds, ServerStats &stat) {
+      while (true) {
+         int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+         if (fd < 0) {
+            return;     // EAGAIN: otro reactor la tomó o no quedan pendientes
+         }
+         int one = 1;
+         setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));   // Falla sin efecto en sockets Unix
+         sessions.emplace_back(new Session(fd, seeds()));
+         epoll_event event{};
+         event.events = EPOLLIN | EPOLLRDHUP;
+         event.data.ptr = sessions.back().get();
+         epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &event);
+         stat.accepted++;
+         stat.sessions = sessions.size();
+         stat.peakSessions = std::max(stat.peakSessions, stat.sessions);
+      }
+   }
+
+   void markDead(int epoll, Session &session) {   // Deja de recibir eventos de la sesión; se libera al final del lote
+      if (!session.dead) {
+         session.dead = true;
+         epoll_ctl(epoll, EPOLL_CTL_DEL, session.fd, nullptr);
+      }
+   }
+
+   void closeSession(int epoll, std::vector<std::unique_ptr<Session>> &sessions, size_t index, ServerStats &stat) {
+      if (!sessions[index]->dead) {
+         epoll_ctl(epoll, EPOLL_CTL_DEL, sessions[index]->fd, nullptr);
+      }
+      close(sessions[index]->fd);
+      sessions[index].swap(sessions.back());
+      sessions.pop_back();
+      stat.sessions = sessions.size();
+   }
+
+   void watchWrites(int epoll, Session &session) {   // Activa EPOLLOUT solo mientras quedan bytes sin enviar
+      bool want = session.output.pending();
+      if (want != session.writing) {
+         epoll_event event{};
+         event.events = uint32_t(EPOLLIN | EPOLLRDHUP) | (want ? uint32_t(EPOLLOUT) : 0u);
+         event.data.ptr = &session;
+         epoll_ctl(epoll, EPOLL_CTL_MOD, session.fd, &event);
+         session.writing = want;
+      }
+   }
+
+   // Aplica cada acción recibida y la confirma; falso si el cliente cerró. Lee una sola vez por
+   // evento: si quedan datos, EPOLLIN (por nivel) vuelve a avisar después de los demás eventos,
+   // así un cliente que inunda el socket no retrasa los ticks ni a las otras sesiones
+   bool readInput(Session &session, ServerStats &stat) {
+      uint8_t bytes[512];
+      ssize_t n = read(session.fd, bytes, sizeof(bytes));
+      if (n == 0) {
+         return false;
+      }
+      if (n < 0) {
+         return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+      }
+      for (ssize_t i = 0; i < n; ++i) {
+         session.input[session.inputLength++] = bytes[i];
+         if (session.inputLength < CLIENT_MESSAGE_BYTES) {
+            continue;
+         }
+         session.inputLength = 0;
+         Action action = session.input[0] < TOGGLE_PAUSE ? static_cast<Action>(session.input[0]) : NO_ACTION;   // Los clientes no pausan el servidor
+         session.game.apply(action);
+         session.output.putU8(MSG_ACK);
+         session.output.putU8(session.input[2]);
+         session.output.putU8(session.input[3]);
+         stat.actions++;
+      }
+      return true;
+   }
+
+   void sendFrame(Session &session, ServerStats &stat) {   // Agrega las diferencias desde el último cuadro enviado
+      GameState &game = session.game;
+      if (game.gameOver) {
+         session.output.putU8(MSG_GAME_OVER);
+         session.output.putU32(uint32_t(game.score));
+         game.reset(game.rng());                  // La sesión sigue con otra partida
+         stat.gamesOver++;
+      }
+      int changedRows = 0;
+      for (int y = 0; y < HEIGHT; ++y) {
+         changedRows += game.board.rows[y] != session.sentRows[y] ? 1 : 0;
+      }
+      const Piece &piece = game.activePiece;
+      bool pieceChanged = !session.pieceKnown || piece.type != session.sentPiece.type || piece.rotation != session.sentPiece.rotation
+                       || piece.x != session.sentPiece.x || piece.y != session.sentPiece.y;
+      bool statsChanged = game.score != session.sentScore || game.linesCleared != session.sentLines || game.level != session.sentLevel;
+      if (!changedRows && !pieceChanged && !statsChanged) {
+         return;     // Nada nuevo para este cliente
+      }
+      size_t before = session.output.bytes.size();
+      OutputBuffer &out = session.output;
+      out.putU8(MSG_FRAME);
+      out.putU32(uint32_t(game.tick));
+      out.putU8((pieceChanged ? FRAME_PIECE : 0) | (statsChanged ? FRAME_STATS : 0));
+      out.putU8(uint8_t(changedRows));
+      for (int y = 0; y < HEIGHT; ++y) {
+         if (game.board.rows[y] != session.sentRows[y]) {
+            out.putU8(uint8_t(y));
+            out.putU16(game.board.rows[y]);
+            session.sentRows[y] = game.board.rows[y];
+         }
+      }
+      if (pieceChanged) {
+         out.putU8(uint8_t(piece.type));
+         out.putU8(uint8_t(piece.rotation));
+         out.putU8(uint8_t(int8_t(piece.x)));
+         out.putU8(uint8_t(int8_t(piece.y)));
+         session.sentPiece = piece;
+         session.pieceKnown = true;
+      }
+      if (statsChanged) {
+         out.putU32(uint32_t(game.score));
+         out.putU16(uint16_t(game.linesCleared));
+         out.putU8(uint8_t(game.level));
+         session.sentScore = game.score;
+         session.sentLines = game.linesCleared;
+         session.sentLevel = game.level;
+      }
+      stat.frames++;
+      stat.bytesOut += out.bytes.size() - before;
+   }
+};
+
+// Resultados del generador de carga
+struct LoadStats {
+   uint64_t sessions = 0, connectFailures = 0, disconnects = 0;
+   uint64_t actionsSent = 0, acks = 0, frames = 0, gamesOver = 0, bytesIn = 0;
+   LatencyHistogram latency;     // Desde que se envía la acción hasta que llega su confirmación
+};
+
+// Abre muchas sesiones contra el servidor y envía acciones al azar a un ritmo fijo por sesión
+class LoadGenerator {
+public:
+   LoadStats run(const SocketAddress &address, int sessionCount, double seconds, double actionsPerSecond, const std::atomic<bool> &stop) {
+      LoadStats stats;
+      int epoll = epoll_create1(EPOLL_CLOEXEC);
+      std::mt19937 rng(12345);
+      uint64_t interval = uint64_t(1e9 / std::max(0.1, actionsPerSecond));
+      uint64_t now = monotonicNs();
+      for (int i = 0; i < sessionCount && !stop; ++i) {
+         int fd = openSocket(address, false);
+         if (fd < 0) {
+            stats.connectFailures++;
+            continue;
+         }
+         clients.emplace_back(new Client());
+         Client &client = *clients.back();
+         client.fd = fd;
+         client.nextSend = now + rng() % interval;     // Reparte los envíos a lo largo del intervalo
+         epoll_event event{};
+         event.events = EPOLLIN | EPOLLRDHUP;
+         event.data.ptr = &client;
+         epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &event);
+      }
+      stats.sessions = clients.size();
+
+      int timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+      itimerspec period{};
+      period.it_interval.tv_nsec = period.it_value.tv_nsec = 1000000;   // Revisa los envíos pendientes cada 1 ms
+      timerfd_settime(timer, 0, &period, nullptr);
+      epoll_event event{};
+      event.events = EPOLLIN;
+      event.data.ptr = nullptr;
+      epoll_ctl(epoll, EPOLL_CTL_ADD, timer, &event);
+
+      uint64_t deadline = monotonicNs() + uint64_t(seconds * 1e9);
+      epoll_event events[256];
+      while (!stop && monotonicNs() < deadline) {
+         int n = epoll_wait(epoll, events, 256, 100);
+         for (int e = 0; e < n; ++e) {
+            if (events[e].data.ptr == nullptr) {
+               uint64_t expirations;
+               if (read(timer, &expirations, sizeof(expirations)) == sizeof(expirations)) {
+                  sendDue(rng, interval, stats);
+               }
+               continue;
+            }
+            Client &client = *static_cast<Client *>(events[e].data.ptr);
+            if (client.fd >= 0 && !receive(client, stats)) {
+               epoll_ctl(epoll, EPOLL_CTL_DEL, client.fd, nullptr);
+               close(client.fd);
+               client.fd = -1;
+               stats.disconnects++;
+            }
+         }
+      }
+      for (std::unique_ptr<Client> &client : clients) {
+         if (client->fd >= 0) {
+            close(client->fd);
+         }
+      }
+      close(timer);
+      close(epoll);
+      return stats;
+   }
+
+private:
+   static const int IN_FLIGHT = 64;     // Acciones sin confirmar que se rastrean por sesión
+
+   struct Client {
+      int fd = -1;
+      uint16_t sequence = 0;
+      uint64_t nextSend = 0;
+      uint64_t sentAt[IN_FLIGHT] = {};
+      std::vector<uint8_t> input;       // Bytes recibidos que todavía no forman un mensaje completo
+   };
+
+   std::vector<std::unique_ptr<Client>> clients;
+
+   void sendDue(std::mt19937 &rng, uint64_t interval, LoadStats &stats) {
+      uint64_t now = monotonicNs();
+      for (std::unique_ptr<Client> &client : clients) {
+         if (client->fd < 0 || client->nextSend > now) {
+            continue;
+         }
+         uint8_t message[CLIENT_MESSAGE_BYTES] = {uint8_t(MOVE_LEFT + rng() % (HARD_DROP - MOVE_LEFT + 1)), 0,
+                                                  uint8_t(client->sequence), uint8_t(client->sequence >> 8)};
+         if (send(client->fd, message, sizeof(message), MSG_NOSIGNAL) == sizeof(message)) {
+            client->sentAt[client->sequence % IN_FLIGHT] = monotonicNs();
+            client->sequence++;
+            stats.actionsSent++;
+         }
+         client->nextSend += interval;
+         if (client->nextSend < now) {
+            client->nextSend = now + interval;     // No acumula envíos atrasados
+         }
+      }
+   }
+
+   bool receive(Client &client, LoadStats &stats) {   // Lee y procesa los mensajes completos; falso si la conexión se cerró o falló
+      uint8_t bytes[4096];
+      while (true) {
+         ssize_t n = read(client.fd, bytes, sizeof(bytes));
+         if (n == 0) {
+            return false;
+         }
+         if (n < 0 && errno == EINTR) {
+            continue;
+         }
+         if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;           // No hay más datos por ahora
+         }
+         if (n < 0) {
+            return false;    // Error del socket (ECONNRESET, ETIMEDOUT...): se cierra como una desconexión
+         }
+         client.input.insert(client.input.end(), bytes, bytes + n);
+         stats.bytesIn += n;
+      }
+      uint64_t now = monotonicNs();
+      size_t pos = 0;
+      const std::vector<uint8_t> &in = client.input;
+      while (pos < in.size()) {
+         size_t left = in.size() - pos;
+         if (in[pos] == MSG_ACK) {
+            if (left < 3) {
+               break;
+            }
+            uint16_t sequence = uint16_t(in[pos + 1] | in[pos + 2] << 8);
+            stats.latency.record(now - client.sentAt[sequence % IN_FLIGHT]);
+            stats.acks++;
+            pos += 3;
+         } else if (in[pos] == MSG_GAME_OVER) {
+            if (left < 5) {
+               break;
+            }
+            stats.gamesOver++;
+            pos += 5;
+         } else if (in[pos] == MSG_FRAME) {
+            if (left < 7) {
+               break;
+            }
+            uint8_t flags = in[pos + 5];
+            size_t size = 7 + in[pos + 6] * 3 + (flags & FRAME_PIECE ? 4 : 0) + (flags & FRAME_STATS ? 7 : 0);
+            if (left < size) {
+               break;
+            }
+            stats.frames++;
+            pos += size;
+         } else {
+            return false;     // Mensaje desconocido: se abandona la sesión
+         }
+      }
+      client.input.erase(client.input.begin(), client.input.begin() + pos);
+      return true;
+   }
+};
+
+#endif
+
+#endif
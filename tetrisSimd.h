@@ -0,0 +1,309 @@
+// Kernels por lotes para colisión, altura de caída y filas completas.
+// Los tableros y las piezas se guardan en formato SoA (estructura de arreglos):
+// la fila y de los BATCH_LANES tableros es contigua, así que una sola instrucción
+// AVX2 procesa la misma fila de 16 tableros. La CPU se detecta en tiempo de
+// ejecución y siempre existe una versión escalar equivalente.
+#ifndef TETRIS_SIMD_H
+#define TETRIS_SIMD_H
+
+#include <cstdint>      // Tipos enteros de tamaño fijo
+#include <algorithm>    // min(), max()
+
+#include "tetrisCore.h"  // Tablero y piezas
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define TETRIS_X86 1
+#include <immintrin.h>  // Intrínsecos SSE4.1 y AVX2
+#ifdef _MSC_VER
+#include <intrin.h>     // __cpuid() en Windows
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TETRIS_TARGET(isa) __attribute__((target(isa)))   // Compila la función para el conjunto de instrucciones indicado
+#else
+#define TETRIS_TARGET(isa)
+#endif
+
+const int BATCH_LANES = 16;                              // Tableros por lote
+const uint32_t ALL_LANES = (1u << BATCH_LANES) - 1;      // Máscara con todos los carriles
+
+// Lote de tableros: rows[y][carril]
+struct BoardBatch {
+   alignas(32) uint16_t rows[HEIGHT][BATCH_LANES] = {};
+
+   void set(int lane, const Board &board) {
+      for (int y = 0; y < HEIGHT; ++y) {
+         rows[y][lane] = board.rows[y];
+      }
+   }
+};
+
+// Lote de piezas ya desplazadas a su posición en el tablero: rows[y][carril].
+// Las celdas que caen fuera del tablero no se pueden guardar en las filas, así que
+// set() marca el carril en outOfBounds y los kernels de colisión lo suman al resultado
+struct PieceBatch {
+   alignas(32) uint16_t rows[HEIGHT][BATCH_LANES] = {};
+   int minRow = HEIGHT, maxRow = -1;      // Filas ocupadas por alguna pieza del lote
+   uint32_t outOfBounds = 0;              // Bit i: la pieza del carril i tiene celdas fuera del tablero
+
+   void set(int lane, const Piece &piece) {
+      for (int y = 0; y < HEIGHT; ++y) {
+         rows[y][lane] = 0;
+      }
+      outOfBounds &= ~(1u << lane);
+      const uint16_t *shape = piece.rows();
+      for (int i = 0; i < MAX_FILAS_PIEZA; ++i) {
+         int y = piece.y + i;
+         if (!shape[i]) {
+            continue;
+         }
+         uint64_t mask = shiftRow(shape[i], piece.x);
+         if (y < 0 || y >= HEIGHT || (mask & ~uint64_t(FULL_MASK)) || (piece.x < 0 && (shape[i] & ((1u << -piece.x) - 1)))) {
+            outOfBounds |= 1u << lane;    // Por arriba, por abajo, por la derecha o por la izquierda
+            continue;
+         }
+         rows[y][lane] = uint16_t(mask);
+         minRow = std::min(minRow, y);
+         maxRow = std::max(maxRow, y);
+      }
+   }
+};
+
+// Niveles de instrucciones vectoriales soportados
+enum SimdLevel {SIMD_SCALAR, SIMD_SSE41, SIMD_AVX2};
+
+inline const char *simdLevelName(SimdLevel level) {
+   return level == SIMD_AVX2 ? "AVX2" : level == SIMD_SSE41 ? "SSE4.1" : "escalar";
+}
+
+inline SimdLevel detectSimdLevel() {   // Detecta en tiempo de ejecución el mejor nivel disponible
+#if defined(TETRIS_X86) && (defined(__GNUC__) || defined(__clang__))
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("avx2")) {
+      return SIMD_AVX2;
+   }
+   if (__builtin_cpu_supports("sse4.1")) {
+      return SIMD_SSE41;
+   }
+#elif defined(TETRIS_X86) && defined(_MSC_VER)
+   int info[4];
+   __cpuid(info, 0);
+   int maxLeaf = info[0];
+   __cpuid(info, 1);
+   bool sse41 = info[2] & (1 << 19), osxsave = info[2] & (1 << 27);
+   if (maxLeaf >= 7 && osxsave && (_xgetbv(0) & 6) == 6) {
+      __cpuidex(info, 7, 0);
+      if (info[1] & (1 << 5)) {
+         return SIMD_AVX2;
+      }
+   }
+   if (sse41) {
+      return SIMD_SSE41;
+   }
+#endif
+   return SIMD_SCALAR;
+}
+
+inline uint32_t compressEvenBits(uint32_t bits) {   // Junta los bits pares (uno por carril de 16 bits en un movemask de bytes)
+   bits &= 0x55555555;
+   bits = (bits | bits >> 1) & 0x33333333;
+   bits = (bits | bits >> 2) & 0x0F0F0F0F;
+   bits = (bits | bits >> 4) & 0x00FF00FF;
+   bits = (bits | bits >> 8) & 0x0000FFFF;
+   return bits;
+}
+
+inline int lowestSetBit(uint32_t bits) {   // Índice del bit menos significativo encendido (bits != 0)
+#ifdef _MSC_VER
+   unsigned long index;
+   _BitScanForward(&index, bits);
+   return int(index);
+#else
+   return __builtin_ctz(bits);
+#endif
+}
+
+// Resultados de un lote
+struct BatchResult {
+   uint32_t collisions = 0;                 // Bit i: la pieza del carril i choca o sale del tablero
+   uint8_t landing[BATCH_LANES] = {};       // Filas que puede bajar cada pieza hasta apoyarse
+   uint32_t fullRows[BATCH_LANES] = {};     // Bit y: la fila y del tablero del carril está completa
+};
+
+// --- Versión escalar ---
+
+inline uint32_t collideScalar(const BoardBatch &boards, const PieceBatch &pieces) {
+   uint32_t result = pieces.outOfBounds;
+   for (int lane = 0; lane < BATCH_LANES; ++lane) {
+      for (int y = pieces.minRow; y <= pieces.maxRow; ++y) {
+         if (pieces.rows[y][lane] & boards.rows[y][lane]) {
+            result |= 1u << lane;
+            break;
+         }
+      }
+   }
+   return result;
+}
+
+inline void landingScalar(const BoardBatch &boards, const PieceBatch &pieces, uint8_t *landing) {
+   for (int lane = 0; lane < BATCH_LANES; ++lane) {
+      int d = 1;
+      for (; d <= HEIGHT; ++d) {
+         bool hit = false;
+         for (int y = pieces.minRow; y <= pieces.maxRow && !hit; ++y) {
+            uint16_t below = y + d < HEIGHT ? boards.rows[y + d][lane] : 0xFFFF;   // El suelo se trata como fila llena
+            hit = pieces.rows[y][lane] & below;
+         }
+         if (hit) {
+            break;
+         }
+      }
+      landing[lane] = uint8_t(d - 1);
+   }
+}
+
+inline void fullRowsScalar(const BoardBatch &boards, uint32_t *fullRows) {
+   for (int lane = 0; lane < BATCH_LANES; ++lane) {
+      fullRows[lane] = 0;
+      for (int y = 0; y < HEIGHT; ++y) {
+         fullRows[lane] |= boards.rows[y][lane] == FULL_MASK ? 1u << y : 0;
+      }
+   }
+}
+
+#ifdef TETRIS_X86
+
+// --- Versión SSE4.1: dos registros de 8 carriles ---
+
+TETRIS_TARGET("sse4.1") inline uint32_t collideSse41(const BoardBatch &boards, const PieceBatch &pieces) {
+   uint32_t result = pieces.outOfBounds;
+   for (int half = 0; half < 2; ++half) {
+      __m128i acc = _mm_setzero_si128();
+      for (int y = pieces.minRow; y <= pieces.maxRow; ++y) {
+         __m128i piece = _mm_load_si128(reinterpret_cast<const __m128i *>(&pieces.rows[y][half * 8]));
+         __m128i board = _mm_load_si128(reinterpret_cast<const __m128i *>(&boards.rows[y][half * 8]));
+         acc = _mm_or_si128(acc, _mm_and_si128(piece, board));
+      }
+      if (!_mm_testz_si128(acc, acc)) {
+         uint32_t free = compressEvenBits(_mm_movemask_epi8(_mm_cmpeq_epi16(acc, _mm_setzero_si128())));
+         result |= (~free & 0xFF) << (half * 8);
+      }
+   }
+   return result;
+}
+
+TETRIS_TARGET("sse4.1") inline void landingSse41(const BoardBatch &boards, const PieceBatch &pieces, uint8_t *landing) {
+   const __m128i floor = _mm_set1_epi16(-1);
+   for (int half = 0; half < 2; ++half) {
+      uint32_t done = 0;
+      for (int d = 1; d <= HEIGHT && done != 0xFF; ++d) {
+         __m128i acc = _mm_setzero_si128();
+         for (int y = pieces.minRow; y <= pieces.maxRow; ++y) {
+            __m128i piece = _mm_load_si128(reinterpret_cast<const __m128i *>(&pieces.rows[y][half * 8]));
+            __m128i below = y + d < HEIGHT ? _mm_load_si128(reinterpret_cast<const __m128i *>(&boards.rows[y + d][half * 8])) : floor;
+            acc = _mm_or_si128(acc, _mm_and_si128(piece, below));
+         }
+         uint32_t hit = ~compressEvenBits(_mm_movemask_epi8(_mm_cmpeq_epi16(acc, _mm_setzero_si128()))) & 0xFF;
+         for (uint32_t fresh = hit & ~done; fresh; fresh &= fresh - 1) {
+            landing[half * 8 + lowestSetBit(fresh)] = uint8_t(d - 1);
+         }
+         done |= hit;
+      }
+      for (uint32_t rest = ~done & 0xFF; rest; rest &= rest - 1) {
+         landing[half * 8 + lowestSetBit(rest)] = uint8_t(HEIGHT);   // Carril sin pieza
+      }
+   }
+}
+
+TETRIS_TARGET("sse4.1") inline void fullRowsSse41(const BoardBatch &boards, uint32_t *fullRows) {
+   const __m128i full = _mm_set1_epi16(int16_t(FULL_MASK));
+   uint32_t byRow[HEIGHT];
+   for (int y = 0; y < HEIGHT; ++y) {
+      __m128i low = _mm_cmpeq_epi16(_mm_load_si128(reinterpret_cast<const __m128i *>(&boards.rows[y][0])), full);
+      __m128i high = _mm_cmpeq_epi16(_mm_load_si128(reinterpret_cast<const __m128i *>(&boards.rows[y][8])), full);
+      byRow[y] = _mm_movemask_epi8(_mm_packs_epi16(low, high));   // Un bit por carril
+   }
+   for (int lane = 0; lane < BATCH_LANES; ++lane) {
+      fullRows[lane] = 0;
+   }
+   for (int y = 0; y < HEIGHT; ++y) {
+      for (uint32_t lanes = byRow[y]; lanes; lanes &= lanes - 1) {
+         fullRows[lowestSetBit(lanes)] |= 1u << y;
+      }
+   }
+}
+
+// --- Versión AVX2: los 16 carriles en un registro ---
+
+TETRIS_TARGET("avx2") inline uint32_t collideAvx2(const BoardBatch &boards, const PieceBatch &pieces) {
+   __m256i acc = _mm256_setzero_si256();
+   for (int y = pieces.minRow; y <= pieces.maxRow; ++y) {
+      __m256i piece = _mm256_load_si256(reinterpret_cast<const __m256i *>(pieces.rows[y]));
+      __m256i board = _mm256_load_si256(reinterpret_cast<const __m256i *>(boards.rows[y]));
+      acc = _mm256_or_si256(acc, _mm256_and_si256(piece, board));
+   }
+   if (_mm256_testz_si256(acc, acc)) {
+      return pieces.outOfBounds;
+   }
+   return pieces.outOfBounds | (~compressEvenBits(_mm256_movemask_epi8(_mm256_cmpeq_epi16(acc, _mm256_setzero_si256()))) & ALL_LANES);
+}
+
+TETRIS_TARGET("avx2") inline void landingAvx2(const BoardBatch &boards, const PieceBatch &pieces, uint8_t *landing) {
+   const __m256i floor = _mm256_set1_epi16(-1);
+   uint32_t done = 0;
+   for (int d = 1; d <= HEIGHT && done != ALL_LANES; ++d) {
+      __m256i acc = _mm256_setzero_si256();
+      for (int y = pieces.minRow; y <= pieces.maxRow; ++y) {
+         __m256i piece = _mm256_load_si256(reinterpret_cast<const __m256i *>(pieces.rows[y]));
+         __m256i below = y + d < HEIGHT ? _mm256_load_si256(reinterpret_cast<const __m256i *>(boards.rows[y + d])) : floor;
+         acc = _mm256_or_si256(acc, _mm256_and_si256(piece, below));
+      }
+      uint32_t hit = ~compressEvenBits(_mm256_movemask_epi8(_mm256_cmpeq_epi16(acc, _mm256_setzero_si256()))) & ALL_LANES;
+      for (uint32_t fresh = hit & ~done; fresh; fresh &= fresh - 1) {
+         landing[lowestSetBit(fresh)] = uint8_t(d - 1);
+      }
+      done |= hit;
+   }
+   for (uint32_t rest = ~done & ALL_LANES; rest; rest &= rest - 1) {
+      landing[lowestSetBit(rest)] = uint8_t(HEIGHT);   // Carril sin pieza
+   }
+}
+
+TETRIS_TARGET("avx2") inline void fullRowsAvx2(const BoardBatch &boards, uint32_t *fullRows) {
+   const __m256i full = _mm256_set1_epi16(int16_t(FULL_MASK));
+   for (int lane = 0; lane < BATCH_LANES; ++lane) {
+      fullRows[lane] = 0;
+   }
+   for (int y = 0; y < HEIGHT; ++y) {
+      __m256i equal = _mm256_cmpeq_epi16(_mm256_load_si256(reinterpret_cast<const __m256i *>(boards.rows[y])), full);
+      for (uint32_t lanes = compressEvenBits(_mm256_movemask_epi8(equal)); lanes; lanes &= lanes - 1) {
+         fullRows[lowestSetBit(lanes)] |= 1u << y;
+      }
+   }
+}
+
+#endif
+
+// Procesa un lote completo con el nivel indicado (que debe estar soportado por la CPU)
+inline void runBatch(SimdLevel level, const BoardBatch &boards, const PieceBatch &pieces, BatchResult &result) {
+#ifdef TETRIS_X86
+   if (level == SIMD_AVX2) {
+      result.collisions = collideAvx2(boards, pieces);
+      landingAvx2(boards, pieces, result.landing);
+      fullRowsAvx2(boards, result.fullRows);
+      return;
+   }
+   if (level == SIMD_SSE41) {
+      result.collisions = collideSse41(boards, pieces);
+      landingSse41(boards, pieces, result.landing);
+      fullRowsSse41(boards, result.fullRows);
+      return;
+   }
+#endif
+   result.collisions = collideScalar(boards, pieces);
+   landingScalar(boards, pieces, result.landing);
+   fullRowsScalar(boards, result.fullRows);
+}
+
+#endif
@@ -0,0 +1,422 @@
+// Solucionador exhaustivo de "perfect clear" con una secuencia de piezas conocida.
+// Dado un tablero y todas las piezas que van a llegar (la activa y las próximas), busca
+// en profundidad una secuencia de colocaciones alcanzables que deje el tablero vacío y,
+// si no existe, la que elimina más líneas. Cada pieza debe quedar dentro de las 'height'
+// filas inferiores (buscando el perfect clear, la caja baja con cada línea eliminada);
+// las posiciones cuyas celdas ya no pueden completar un número entero de líneas con las
+// piezas que quedan se descartan, y las posiciones repetidas (mismo tablero y misma pieza
+// por colocar) se reconocen en una tabla de transposición compartida. Los primeros niveles
+// se expanden en amplitud y las ramas resultantes se reparten entre los hilos del pool,
+// que se roban el trabajo entre sí; otro hilo informa el progreso mientras tanto.
+#ifndef TETRIS_SOLVER_H
+#define TETRIS_SOLVER_H
+
+#include <vector>              // Ramas y colocaciones
+#include <array>               // Caminos de tamaño fijo
+#include <atomic>              // Contadores y banderas compartidos
+#include <thread>              // Hilo de progreso
+#include <mutex>               // Solución encontrada y espera del hilo de progreso
+#include <condition_variable>  // Despertar al hilo de progreso al terminar
+#include <functional>          // Función de progreso
+#include <unordered_set>       // Posiciones repetidas al expandir los primeros niveles
+#include <chrono>              // Nodos por segundo
+#include <algorithm>           // min()
+
+#include "tetrisCore.h"  // Tablero y piezas
+#include "tetrisMoves.h" // Generador de colocaciones
+#include "tetrisHash.h"  // Tabla de transposición
+#include "tetrisBot.h"   // Pool de hilos con robo de tareas
+
+const int MAX_PIEZAS_SOLUCION = 16;    // Máximo de piezas de la secuencia
+
+// Objetivo de la búsqueda
+enum SolverMode {SOLVE_CLEAR, SOLVE_LINES};
+const int NUM_SOLVER_MODES = 2;
+
+// Contadores de la búsqueda
+struct SolverStats {
+   uint64_t considered = 0;      // Colocaciones generadas
+   uint64_t nodes = 0;           // Colocaciones aplicadas que sobrevivieron a las podas
+   uint64_t prunedHeight = 0;    // Descartadas por salirse del límite de altura
+   uint64_t prunedParity = 0;    // Descartadas porque las celdas no pueden completar las líneas que faltan
+   uint64_t duplicates = 0;      // Posiciones ya resueltas (tabla de transposición)
+   double seconds = 0;
+
+   double nodesPerSecond() const { return seconds > 0 ? nodes / seconds : 0; }
+   double pruneRate() const { return considered ? double(prunedHeight + prunedParity + duplicates) / considered : 0; }
+};
+
+// Resultado: la secuencia de colocaciones (en orden) y lo que logra
+struct SolverResult {
+   bool perfectClear = false;    // El tablero queda vacío tras la última colocación
+   int lines = 0;                // Líneas eliminadas por la secuencia
+   int pieces = 0;               // Colocaciones de la secuencia
+   std::array<Piece, MAX_PIEZAS_SOLUCION> moves{};
+   SolverStats stats;
+};
+
+template <typename G>
+class BasicPerfectClearSolver {
+public:
+   using Board = BasicBoard<G>;
+   using Progress = std::function<void(const SolverStats &stats, SolverMode mode, int bestLines)>;
+
+   BasicPerfectClearSolver(ThreadPool &pool, TranspositionTable &table) : pool(pool), table(table) {
+      uint64_t state = 0x5EED5EED;
+      for (auto &keys : indexKeys) {
+         for (uint64_t &key : keys) {
+            key = splitMix64(state);
+         }
+      }
+   }
+
+   // Busca primero el perfect clear y, si no existe, el máximo de líneas. 'progress' se
+   // llama cada 'interval' desde otro hilo con los contadores acumulados
+   SolverResult solve(const Board &board, const Tetromino *sequence, int count, int height, const Progress &progress,
+                      std::chrono::milliseconds interval = std::chrono::milliseconds(250)) {
+      this->count = std::min(count, MAX_PIEZAS_SOLUCION);
+      this->height = std::min(height, G::HEIGHT);
+      std::copy(sequence, sequence + this->count, pieces.begin());
+      for (auto &counter : totals) {
+         counter = 0;
+      }
+      stopped = false;
+      bestLines = -1;
+      started = std::chrono::steady_clock::now();
+      bool done = false;
+      std::thread reporter([&] {
+         std::unique_lock<std::mutex> lock(reporterMutex);
+         while (!reporterWake.wait_for(lock, interval, [&] { return done; })) {
+            progress(snapshot(), mode, bestLines);
+         }
+      });
+
+      SolverResult result = search(board, SOLVE_CLEAR);
+      if (!result.perfectClear && !stopped) {
+         result = search(board, SOLVE_LINES);
+      }
+
+      {
+         std::lock_guard<std::mutex> lock(reporterMutex);
+         done = true;
+      }
+      reporterWake.notify_all();
+      reporter.join();
+      result.stats = snapshot();
+      return result;
+   }
+
+   void cancel() { stopped = true; }     // Corta la búsqueda (p. ej. con Ctrl + C); retorna lo mejor hallado
+
+private:
+   // Memoria de cada hilo, reservada la primera vez que el hilo busca
+   struct Scratch {
+      BasicMoveGenerator<G> generator;
+      std::array<std::vector<Placement>, MAX_PIEZAS_SOLUCION> placements;   // Una lista por nivel de la búsqueda
+   };
+
+   // Rama de los primeros niveles: posición alcanzada y el camino hasta ella
+   struct Branch {
+      Board board;
+      int index = 0;             // Pieza por colocar
+      int lines = 0;             // Líneas eliminadas hasta aquí
+      std::array<Piece, MAX_PIEZAS_SOLUCION> path{};
+   };
+
+   enum Counter {CONSIDERED, NODES, PRUNED_HEIGHT, PRUNED_PARITY, DUPLICATES, NUM_COUNTERS};
+
+   ThreadPool &pool;
+   TranspositionTable &table;
+   std::array<std::array<uint64_t, MAX_PIEZAS_SOLUCION + 1>, NUM_SOLVER_MODES> indexKeys;
+   std::array<Tetromino, MAX_PIEZAS_SOLUCION> pieces{};
+   int count = 0, height = 0;
+   std::atomic<SolverMode> mode{SOLVE_CLEAR};   // Fase en curso (la lee el hilo de progreso)
+   std::atomic<bool> stopped{false};
+   std::atomic<int> bestLines{-1};   // Mejor resultado completo hasta ahora (modo de líneas)
+   std::atomic<uint64_t> totals[NUM_COUNTERS] = {};
+   std::chrono::steady_clock::time_point started;
+   std::mutex reporterMutex, resultMutex;
+   std::condition_variable reporterWake;
+
+   static Scratch &scratch() {
+      static thread_local Scratch local;
+      return local;
+   }
+
+   SolverStats snapshot() const {
+      SolverStats stats;
+      stats.considered = totals[CONSIDERED];
+      stats.nodes = totals[NODES];
+      stats.prunedHeight = totals[PRUNED_HEIGHT];
+      stats.prunedParity = totals[PRUNED_PARITY];
+      stats.duplicates = totals[DUPLICATES];
+      stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+      return stats;
+   }
+
+   void flush(std::array<uint64_t, NUM_COUNTERS> &local) {   // Pasa los contadores del hilo a los compartidos
+      for (int c = 0; c < NUM_COUNTERS; ++c) {
+         totals[c].fetch_add(local[c], std::memory_order_relaxed);
+         local[c] = 0;
+      }
+   }
+
+   uint64_t stateKey(const Board &board, int index, SolverMode searchMode) const { return board.hash ^ indexKeys[searchMode][index]; }
+
+   static int pieceTop(const Piece &piece) {   // Fila más alta que ocupa la pieza
+      const uint16_t *shape = piece.rows();
+      int i = 0;
+      while (!shape[i]) {
+         ++i;
+      }
+      return piece.y + i;
+   }
+
+   // Con 'remaining' piezas (4 celdas cada una), ¿puede quedar vacía alguna altura L entre la cima
+   // actual y la caja? Hacen falta exactamente WIDTH * L - celdas celdas nuevas
+   bool parityAllows(const Board &board, int box, int remaining) const {
+      for (int rows = board.maxHeight(); rows <= box; ++rows) {
+         int need = G::WIDTH * rows - board.cellCount;
+         if (need >= 0 && need % 4 == 0 && need <= 4 * remaining) {
+            return true;
+         }
+      }
+      return false;
+   }
+
+   // Aplica la colocación sobre 'next' si respeta el límite de altura y, buscando el perfect
+   // clear, la paridad de celdas; falso si la rama se poda
+   bool tryPlacement(SolverMode searchMode, const Board &board, int index, int lines, const Piece &piece, Board &next, int &cleared,
+                     std::array<uint64_t, NUM_COUNTERS> &local) {
+      local[CONSIDERED]++;
+      int box = searchMode == SOLVE_CLEAR ? height - lines : height;
+      if (pieceTop(piece) < G::HEIGHT - box) {
+         local[PRUNED_HEIGHT]++;
+         return false;
+      }
+      next = board;
+      next.placePiece(piece);
+      cleared = next.clearFullLines();
+      if (searchMode == SOLVE_CLEAR && next.cellCount && !parityAllows(next, box - cleared, count - index - 1)) {
+         local[PRUNED_PARITY]++;
+         return false;
+      }
+      if ((++local[NODES] & 4095) == 0) {
+         flush(local);
+      }
+      return true;
+   }
+
+   // Perfect clear desde la posición: retorna las piezas usadas (0 si no hay) y deja el camino en 'path'
+   int searchClear(const Board &board, int index, int lines, Piece *path, Scratch &memory, std::array<uint64_t, NUM_COUNTERS> &local) {
+      if (stopped) {
+         return 0;
+      }
+      std::vector<Placement> &placements = memory.placements[index];
+      memory.generator.generate(board, pieces[index], placements);
+      Board next;
+      int cleared;
+      for (const Placement &placement : placements) {
+         if (!tryPlacement(SOLVE_CLEAR, board, index, lines, placement.piece, next, cleared, local)) {
+            continue;
+         }
+         path[index] = placement.piece;
+         if (next.cellCount == 0) {
+            return index + 1;
+         }
+         uint64_t key = stateKey(next, index + 1, SOLVE_CLEAR);
+         TTData data;
+         if (table.probe(key, data)) {
+            local[DUPLICATES]++;   // Ya se sabe que desde ahí no hay perfect clear
+            continue;
+         }
+         if (int used = searchClear(next, index + 1, lines + cleared, path, memory, local)) {
+            return used;
+         }
+         if (!stopped) {
+            table.store(key, TTData());
+         }
+      }
+      return 0;
+   }
+
+   // Máximo de líneas que se pueden eliminar desde la posición con las piezas que quedan.
+   // El resultado es exacto, así que se guarda junto con la mejor colocación para reconstruir el camino
+   int searchLines(const Board &board, int index, Scratch &memory, std::array<uint64_t, NUM_COUNTERS> &local) {
+      if (index == count || stopped) {
+         return 0;
+      }
+      int bound = (board.cellCount + 4 * (count - index)) / G::WIDTH;   // Cada línea consume WIDTH celdas
+      std::vector<Placement> &placements = memory.placements[index];
+      memory.generator.generate(board, pieces[index], placements);
+      TTData best;
+      Board next;
+      int cleared;
+      for (const Placement &placement : placements) {
+         if (!tryPlacement(SOLVE_LINES, board, index, 0, placement.piece, next, cleared, local)) {
+            continue;
+         }
+         int total = cleared;
+         if (index + 1 < count) {
+            TTData data;
+            if (table.probe(stateKey(next, index + 1, SOLVE_LINES), data)) {
+               local[DUPLICATES]++;
+               total += int(data.score);
+            } else {
+               total += searchLines(next, index + 1, memory, local);
+            }
+         }
+         if (!best.hasMove || total > best.score) {
+            best.score = float(total);
+            best.hasMove = true;
+            best.move = placement.piece;
+         }
+         if (total >= bound) {
+            break;     // Ninguna otra colocación puede superarla
+         }
+      }
+      if (!stopped) {
+         best.depth = int8_t(count - index);
+         table.store(stateKey(board, index, SOLVE_LINES), best);
+      }
+      return int(best.score);
+   }
+
+   // Expande los primeros niveles en amplitud hasta tener varias ramas por hilo
+   std::vector<Branch> split(SolverMode searchMode, const Board &board, SolverResult &result) {
+      std::array<uint64_t, NUM_COUNTERS> local{};
+      Scratch &memory = scratch();
+      std::vector<Branch> frontier(1);
+      frontier[0].board = board;
+      size_t target = pool.size() * 16;
+      for (int depth = 0; depth + 1 < count && frontier.size() < target && !frontier.empty(); ++depth) {
+         std::vector<Branch> expanded;
+         std::unordered_set<uint64_t> seen;
+         for (const Branch &branch : frontier) {
+            if (branch.index != depth) {
+               expanded.push_back(branch);     // Rama que ya terminó (modo de líneas)
+               continue;
+            }
+            std::vector<Placement> &placements = memory.placements[depth];
+            memory.generator.generate(branch.board, pieces[depth], placements);
+            bool any = false;
+            Branch child = branch;
+            int cleared;
+            for (const Placement &placement : placements) {
+               if (!tryPlacement(searchMode, branch.board, depth, branch.lines, placement.piece, child.board, cleared, local)) {
+                  continue;
+               }
+               any = true;
+               child.index = depth + 1;
+               child.lines = branch.lines + cleared;
+               child.path[depth] = placement.piece;
+               if (searchMode == SOLVE_CLEAR && child.board.cellCount == 0) {
+                  result.perfectClear = true;
+                  result.lines = child.lines;
+                  result.pieces = child.index;
+                  result.moves = child.path;
+                  flush(local);
+                  return {};
+               }
+               if (!seen.insert(stateKey(child.board, child.index, searchMode)).second) {
+                  local[DUPLICATES]++;
+                  continue;
+               }
+               expanded.push_back(child);
+            }
+            if (!any && searchMode == SOLVE_LINES) {
+               expanded.push_back(branch);     // Ninguna colocación cabe: la secuencia termina aquí
+            }
+         }
+         frontier.swap(expanded);
+      }
+      flush(local);
+      return frontier;
+   }
+
+   SolverResult search(const Board &board, SolverMode searchMode) {
+      mode = searchMode;
+      SolverResult result;
+      std::vector<Branch> frontier = split(searchMode, board, result);
+      if (result.perfectClear || frontier.empty()) {
+         return result;
+      }
+      if (searchMode == SOLVE_CLEAR) {
+         std::atomic<bool> found{false};
+         pool.parallelFor(int(frontier.size()), [&](int b) {
+            if (stopped) {
+               return;
+            }
+            std::array<uint64_t, NUM_COUNTERS> local{};
+            Branch branch = frontier[b];
+            int used = searchClear(branch.board, branch.index, branch.lines, branch.path.data(), scratch(), local);
+            flush(local);
+            std::lock_guard<std::mutex> lock(resultMutex);
+            if (used && !found) {
+               found = true;
+               stopped = true;     // Basta una solución: los demás hilos abandonan sus ramas
+               result.perfectClear = true;
+               result.lines = (board.cellCount + 4 * used) / G::WIDTH;   // Todas las celdas terminan en líneas eliminadas
+               result.pieces = used;
+               result.moves = branch.path;
+            }
+         });
+         if (found) {
+            stopped = false;       // La búsqueda terminó por la solución, no por cancelación
+         }
+         return result;
+      }
+
+      std::vector<int> branchLines(frontier.size());
+      pool.parallelFor(int(frontier.size()), [&](int b) {
+         std::array<uint64_t, NUM_COUNTERS> local{};
+         const Branch &branch = frontier[b];
+         branchLines[b] = branch.lines + searchLines(branch.board, branch.index, scratch(), local);
+         flush(local);
+         int previous = bestLines;
+         while (branchLines[b] > previous && !bestLines.compare_exchange_weak(previous, branchLines[b])) {
+         }
+      });
+      size_t best = std::max_element(branchLines.begin(), branchLines.end()) - branchLines.begin();
+      result = reconstruct(frontier[best]);
+      return result;
+   }
+
+   // Sigue las mejores colocaciones guardadas en la tabla desde la rama ganadora; si otra
+   // posición ocupó la entrada, vuelve a resolver ese nodo
+   SolverResult reconstruct(const Branch &branch) {
+      SolverResult result;
+      result.moves = branch.path;
+      result.lines = branch.lines;
+      Board board = branch.board;
+      int index = branch.index;
+      std::array<uint64_t, NUM_COUNTERS> local{};
+      while (index < count) {
+         TTData data;
+         if (!table.probe(stateKey(board, index, SOLVE_LINES), data)) {
+            searchLines(board, index, scratch(), local);
+            if (!table.probe(stateKey(board, index, SOLVE_LINES), data)) {
+               break;      // Cancelada o la entrada se reemplazó de inmediato
+            }
+         }
+         if (!data.hasMove) {
+            break;         // Ninguna colocación cabe
+         }
+         result.moves[index++] = data.move;
+         board.placePiece(data.move);
+         result.lines += board.clearFullLines();
+      }
+      flush(local);
+      result.pieces = index;
+      return result;
+   }
+};
+
+// Geometría de la búsqueda: las piezas nunca pasan de las filas inferiores y, con 6 filas libres
+// por encima, las colocaciones alcanzables son las mismas que en el tablero de 20 filas; el
+// generador recorre así 12 filas en lugar de 20
+using SolverGeometry = Geometry<WIDTH, 12>;
+const int MAX_ALTURA_SOLUCION = SolverGeometry::HEIGHT - 6;
+using PerfectClearSolver = BasicPerfectClearSolver<SolverGeometry>;
+
+#endif
@@ -0,0 +1,150 @@
+// Entrada de teclado por eventos para Linux/Unix: la terminal queda en modo crudo y
+// no bloqueante durante toda la partida, y las teclas (incluidas las flechas, que
+// llegan como secuencias de escape) se traducen directamente a acciones del juego.
+#ifndef TETRIS_TERMINAL_H
+#define TETRIS_TERMINAL_H
+
+#include <cstdint>      // Tipos enteros de tamaño fijo
+#include <ostream>      // Impresión del histograma
+
+#include "tetrisCore.h"  // Acciones del juego
+
+#ifndef _WIN32
+#include <termios.h>    // Modo crudo de la terminal
+#include <unistd.h>     // read()
+#include <fcntl.h>      // Modo no bloqueante
+#include <ctime>        // Reloj monotónico
+
+inline uint64_t monotonicNs() {   // Reloj monotónico en nanosegundos (el mismo que usan los temporizadores timerfd)
+   timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return uint64_t(now.tv_sec) * 1000000000ull + now.tv_nsec;
+}
+
+// Pone la terminal en modo crudo y la restaura al destruirse. Con VMIN = VTIME = 0 la lectura
+// ya no bloquea; no se usa O_NONBLOCK porque en una terminal la entrada y la salida comparten
+// la descripción de archivo y la salida también dejaría de bloquear
+class RawTerminal {
+public:
+   RawTerminal() {
+      active = tcgetattr(STDIN_FILENO, &saved) == 0;
+      if (active) {
+         termios raw = saved;
+         raw.c_lflag &= ~(ICANON | ECHO);     // Sin modo canónico ni eco; Ctrl + C sigue generando SIGINT
+         raw.c_cc[VMIN] = 0;
+         raw.c_cc[VTIME] = 0;
+         tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+      }
+   }
+
+   ~RawTerminal() { restore(); }
+
+   void restore() {   // Vuelve al modo original (antes de imprimir el final de la partida)
+      if (active) {
+         tcsetattr(STDIN_FILENO, TCSANOW, &saved);
+         active = false;
+      }
+   }
+
+   RawTerminal(const RawTerminal &) = delete;
+   RawTerminal &operator=(const RawTerminal &) = delete;
+
+private:
+   termios saved{};
+   bool active = false;
+};
+#endif
+
+// Traduce bytes del teclado a acciones; conserva el estado entre lecturas por si una secuencia de escape llega partida
+class KeyDecoder {
+public:
+   // Decodifica 'count' bytes y escribe las acciones en 'actions'; retorna cuántas hay
+   int decode(const char *bytes, int count, Action *actions) {
+      int n = 0;
+      for (int i = 0; i < count; ++i) {
+         char key = bytes[i];
+         if (state == 1) {                         // Tras ESC se espera '[' (o 'O' en modo aplicación)
+            state = key == '[' || key == 'O' ? 2 : 0;
+            if (state == 2) {
+               continue;
+            }                                      // ESC suelto: el byte siguiente es otra tecla
+         }
+         if (state == 2) {                         // Letra final de la flecha
+            state = 0;
+            switch (key) {
+               case 'D': actions[n++] = MOVE_LEFT; break;     // Flecha izquierda
+               case 'C': actions[n++] = MOVE_RIGHT; break;    // Flecha derecha
+               case 'B': actions[n++] = SOFT_DROP; break;     // Flecha abajo
+               case 'A': actions[n++] = ROTATE; break;        // Flecha arriba (rotar la pieza)
+            }
+            continue;
+         }
+         switch (key) {
+            case '\033': state = 1; break;
+            case 'p': case 'P': actions[n++] = TOGGLE_PAUSE; break;   // Pausar/reanudar
+            case 'a': actions[n++] = MOVE_LEFT; break;                // 'a' para mover izquierda
+            case 'd': actions[n++] = MOVE_RIGHT; break;               // 'd' para mover derecha
+            case 's': actions[n++] = SOFT_DROP; break;                // 's' para bajar
+            case 'w': actions[n++] = ROTATE; break;                   // 'w' para rotar
+            case ' ': actions[n++] = HARD_DROP; break;                // Barra espaciadora para colocar la pieza
+         }
+      }
+      return n;
+   }
+
+private:
+   int state = 0;     // 0 = normal, 1 = tras ESC, 2 = tras ESC [
+};
+
+// Histograma de latencias en cubetas de potencias de dos (microsegundos)
+class LatencyHistogram {
+public:
+   static const int BUCKETS = 24;     // Hasta ~8 s
+
+   void record(uint64_t ns) {
+      uint64_t us = ns / 1000;
+      int bucket = 0;
+      while (bucket < BUCKETS - 1 && (1ull << bucket) <= us) {
+         ++bucket;
+      }
+      counts[bucket]++;
+      total++;
+   }
+
+   void merge(const LatencyHistogram &other) {   // Suma las muestras de otro histograma (uno por hilo)
+      for (int b = 0; b < BUCKETS; ++b) {
+         counts[b] += other.counts[b];
+      }
+      total += other.total;
+   }
+
+   uint64_t percentileUs(double fraction) const {   // Límite superior de la cubeta que contiene el percentil
+      uint64_t target = uint64_t(fraction * total), seen = 0;
+      for (int b = 0; b < BUCKETS; ++b) {
+         seen += counts[b];
+         if (seen > target) {
+            return 1ull << b;
+         }
+      }
+      return 1ull << (BUCKETS - 1);
+   }
+
+   void print(std::ostream &out, const char *title) const {
+      out << title << " (" << total << " muestras):\n";
+      for (int b = 0; b < BUCKETS; ++b) {
+         if (counts[b]) {
+            out << "   < " << (1ull << b) << " us: " << counts[b] << "\n";
+         }
+      }
+      if (total) {
+         out << "   p50 < " << percentileUs(0.5) << " us, p99 < " << percentileUs(0.99) << " us\n";
+      }
+   }
+
+   uint64_t total = 0;
+
+private:
+   uint64_t counts[BUCKETS] = {};
+};
+
+#endif
@@ -0,0 +1,367 @@
+// Pruebas del núcleo del juego con verificaciones explícitas.
+// Cubren las patadas SRS de rotatePiece, las métricas y el hash incrementales del tablero
+// frente a un recálculo completo, el teclado, las semillas de 64 bits, la grabación y
+// reproducción de partidas (también tras reiniciar la partida), las jugadas de la tabla de
+// transposición y los conteos de perft del generador de colocaciones. Termina con código
+// distinto de cero si falla alguna verificación.
+//
+// tetrisTests
+#include <iostream>     // Informe de fallos
+#include <vector>       // Secuencias y buffers
+#include <string>       // Bytes de teclado
+#include <random>       // Acciones al azar
+#include <cstdio>       // remove()
+
+#include "tetrisCore.h"  // Tablero, piezas y estado de la partida
+#include "tetrisMoves.h" // Generador de colocaciones y perft
+#include "tetrisBot.h"   // Recálculo completo de las características
+#include "tetrisReplay.h" // Grabación y reproducción
+#include "tetrisHash.h"  // Tabla de transposición
+#include "tetrisTerminal.h" // Decodificación del teclado
+
+using namespace std;
+
+int fallos = 0;      // Verificaciones fallidas
+int totalChecks = 0; // Verificaciones ejecutadas
+
+// No usa assert(): en Release (NDEBUG) desaparecería
+#define CHECK(cond) check((cond), #cond, __FILE__, __LINE__)
+#define CHECK_EQ(a, b) checkEqual((a), (b), #a " == " #b, __FILE__, __LINE__)
+
+void check(bool ok, const char *expr, const char *file, int line) {
+   totalChecks++;
+   if (!ok) {
+      fallos++;
+      cerr << file << ":" << line << ": falló " << expr << "\n";
+   }
+}
+
+template <typename A, typename B>
+void checkEqual(const A &a, const B &b, const char *expr, const char *file, int line) {
+   totalChecks++;
+   if (!(a == b)) {
+      fallos++;
+      cerr << file << ":" << line << ": falló " << expr << " (" << a << " != " << b << ")\n";
+   }
+}
+
+// --- Patadas SRS ---
+
+Piece makePiece(Tetromino type, int rotation, int x, int y) {
+   Piece piece(type);
+   piece.rotation = rotation;
+   piece.x = x;
+   piece.y = y;
+   return piece;
+}
+
+void checkRotation(const Board &board, Piece piece, bool rotates, int rotation, int x, int y, const char *name) {
+   bool ok = board.rotatePiece(piece);
+   if (ok != rotates || piece.rotation != rotation || piece.x != x || piece.y != y) {
+      fallos++;
+      cerr << "SRS " << name << ": rota " << ok << " a (" << piece.rotation << ", " << piece.x << ", " << piece.y
+           << "), se esperaba " << rotates << " a (" << rotation << ", " << x << ", " << y << ")\n";
+   }
+   totalChecks++;
+}
+
+void testSrsKicks() {
+   Board empty;
+   // Sin obstáculos la T gira en su sitio
+   checkRotation(empty, Board::spawn(T), true, 1, 4, 0, "T libre");
+   // La O nunca cambia
+   checkRotation(empty, makePiece(O, 0, 4, 10), true, 0, 4, 10, "O");
+   // T vertical contra la pared izquierda: R -> 2 no cabe en su sitio y la segunda patada (+1, 0) la mueve a la derecha
+   checkRotation(empty, makePiece(T, 1, -1, 10), true, 2, 0, 10, "T pared izquierda");
+   // I horizontal recién aparecida: la vertical sale por arriba y recién la cuarta patada (-2, +1) cabe
+   checkRotation(empty, Board::spawn(I), true, 1, 1, 0, "I aparición");
+   // I vertical contra la pared derecha: R -> 2 no cabe y la patada (-1, 0) la mete en el tablero
+   checkRotation(empty, makePiece(I, 1, 7, 10), true, 2, 6, 10, "I pared derecha");
+
+   // Sin ninguna posición libre la rotación falla y la pieza no cambia
+   Board full;
+   for (int y = 8; y < HEIGHT; ++y) {
+      for (int x = 0; x < WIDTH; ++x) {
+         if (!(x == 5 && y >= 10 && y < 14)) {
+            full.fillCell(x, y);
+         }
+      }
+   }
+   checkRotation(full, makePiece(I, 1, 3, 10), false, 1, 3, 10, "I encerrada");
+}
+
+// canPlacePiece en el tablero vacío acepta exactamente las posiciones con todas las celdas dentro,
+// también con filas de 32 bits (anchos de 17 a 32) y de 64 bits
+template <typename G>
+void testBounds() {
+   BasicBoard<G> empty;
+   for (int type = 0; type < NUM_TETROMINOS; ++type) {
+      for (int rotation = 0; rotation < NUM_ROTACIONES; ++rotation) {
+         for (int x = -4; x <= G::WIDTH + 4; ++x) {
+            for (int y = -4; y <= G::HEIGHT + 4; ++y) {
+               Piece piece = makePiece(static_cast<Tetromino>(type), rotation, x, y);
+               bool inside = true;
+               for (int i = 0; i < MAX_FILAS_PIEZA; ++i) {
+                  for (int k = 0; k < MAX_FILAS_PIEZA; ++k) {
+                     if (piece.rows()[i] >> k & 1) {
+                        inside = inside && x + k >= 0 && x + k < G::WIDTH && y + i >= 0 && y + i < G::HEIGHT;
+                     }
+                  }
+               }
+               CHECK_EQ(empty.canPlacePiece(piece, 0, 0), inside);
+            }
+         }
+      }
+   }
+}
+
+// --- Teclado ---
+
+vector<int> decodeKeys(KeyDecoder &decoder, const string &bytes) {
+   Action actions[64];
+   int n = decoder.decode(bytes.data(), int(bytes.size()), actions);
+   return vector<int>(actions, actions + n);
+}
+
+void testKeyDecoder() {
+   KeyDecoder decoder;
+   CHECK(decodeKeys(decoder, "\033[D\033OC") == vector<int>({MOVE_LEFT, MOVE_RIGHT}));
+   // Un ESC suelto no se come la tecla siguiente
+   CHECK(decodeKeys(decoder, "\033d") == vector<int>({MOVE_RIGHT}));
+   CHECK(decodeKeys(decoder, "\033\033[A ") == vector<int>({ROTATE, HARD_DROP}));
+   // Secuencias partidas entre lecturas
+   CHECK(decodeKeys(decoder, "\033").empty());
+   CHECK(decodeKeys(decoder, "[").empty());
+   CHECK(decodeKeys(decoder, "Bs") == vector<int>({SOFT_DROP, SOFT_DROP}));
+   CHECK(decodeKeys(decoder, "\033").empty());
+   CHECK(decodeKeys(decoder, "p") == vector<int>({TOGGLE_PAUSE}));
+}
+
+// --- Métricas y hash incrementales ---
+
+template <typename G>
+uint64_t scanHash(const BasicBoard<G> &board) {   // Hash Zobrist recalculado desde las filas
+   uint64_t hash = 0;
+   for (int y = 0; y < G::HEIGHT; ++y) {
+      hash ^= rowHash<G>(y, board.rows[y]);
+   }
+   return hash;
+}
+
+template <typename G>
+void checkBoardMetrics(const BasicBoard<G> &board) {
+   BoardFeatures incremental = computeFeatures(board), scanned = scanFeatures(board);
+   CHECK_EQ(incremental.aggregateHeight, scanned.aggregateHeight);
+   CHECK_EQ(incremental.holes, scanned.holes);
+   CHECK_EQ(incremental.bumpiness, scanned.bumpiness);
+   CHECK_EQ(incremental.wells, scanned.wells);
+   CHECK_EQ(board.hash, scanHash(board));
+   int cells = 0;
+   for (int x = 0; x < G::WIDTH; ++x) {
+      int column = 0, height = 0;
+      for (int y = 0; y < G::HEIGHT; ++y) {
+         column += board.cell(x, y);
+         height = height ? height : board.cell(x, y) ? G::HEIGHT - y : 0;
+      }
+      CHECK_EQ(int(board.columnHeights[x]), height);
+      CHECK_EQ(int(board.columnCells[x]), column);
+      cells += column;
+   }
+   CHECK_EQ(board.cellCount, cells);
+}
+
+// Juega partidas con acciones al azar y compara las métricas tras cada pieza fijada
+template <typename G>
+void testIncrementalMetrics(int games) {
+   mt19937 rng(2024);
+   for (int g = 0; g < games; ++g) {
+      BasicGameState<G> game(rng());
+      uint64_t pieces = 0;
+      while (!game.gameOver && game.piecesPlaced < 300) {
+         game.step(static_cast<Action>(rng() % HARD_DROP + 1));   // Movimientos, rotación y caída
+         if (game.piecesPlaced != pieces) {
+            pieces = game.piecesPlaced;
+            checkBoardMetrics(game.board);
+         }
+      }
+   }
+   BasicBoard<G> board;   // Celdas sueltas (tableros cargados de un archivo)
+   for (int k = 0; k < 200; ++k) {
+      board.fillCell(int(rng() % G::WIDTH), G::HEIGHT - 1 - int(rng() % (G::HEIGHT / 2)));
+      checkBoardMetrics(board);
+   }
+}
+
+// --- Semillas ---
+
+vector<int> pieceSequence(uint64_t seed, int count) {
+   GameState game(seed);
+   vector<int> types;
+   for (int k = 0; k < count; ++k) {
+      types.push_back(game.createRandomPiece().type);
+   }
+   return types;
+}
+
+void testSeeds() {
+   // Las semillas que solo difieren en los 32 bits altos dan partidas distintas
+   CHECK(pieceSequence(5, 64) != pieceSequence(5 | 1ull << 32, 64));
+   CHECK(pieceSequence(1ull << 40, 64) != pieceSequence(1ull << 41, 64));
+   CHECK(pieceSequence(1ull << 40, 64) == pieceSequence(1ull << 40, 64));
+   // Las menores que 2^32 inicializan el generador como siempre (repeticiones y perft anteriores)
+   mt19937 direct(0xDEADBEEF), seeded;
+   seedPieceGenerator(seeded, 0xDEADBEEF);
+   CHECK(direct == seeded);
+}
+
+// --- Grabación y reproducción ---
+
+template <typename G>
+void playRandom(BasicGameState<G> &game, ReplayRecorder &recorder, mt19937 &rng, int ticks) {
+   for (int t = 0; t < ticks && !game.gameOver; ++t) {
+      Action action = rng() % 3 ? NO_ACTION : static_cast<Action>(rng() % HARD_DROP + 1);
+      if (action != NO_ACTION) {
+         recorder.record(game.tick, action);
+      }
+      game.step(action);
+   }
+}
+
+template <typename G>
+void checkReplay(const char *path, ReplayRecorder &recorder, const BasicGameState<G> &game, BoardVariant variant) {
+   CHECK(recorder.save(path, game));
+   MappedFile file(path);
+   CHECK(file.ok());
+   if (!file.ok()) {
+      return;
+   }
+   ReplayResult result = playReplay(file.data(), file.size());
+   CHECK(result.error == nullptr);
+   CHECK(result.matches);
+   CHECK_EQ(int(result.variant), int(variant));
+   CHECK_EQ(result.ticks, game.tick);
+   CHECK_EQ(result.score, game.score);
+   CHECK_EQ(result.boardHash, game.board.hash);
+   CHECK_EQ(result.actions, uint64_t(recorder.actions));
+
+   vector<uint8_t> corrupted(file.data(), file.data() + file.size());
+   corrupted[corrupted.size() - REPLAY_FOOTER_BYTES + 8] ^= 1;   // Otro puntaje en el pie
+   CHECK(!playReplay(corrupted.data(), corrupted.size()).matches);
+}
+
+void testReplayRoundTrip() {
+   const char *path = "tetrisTests.ttr";
+   mt19937 rng(77);
+   {
+      GameState game(123);
+      ReplayRecorder recorder(123);
+      playRandom(game, recorder, rng, 20000);
+      checkReplay(path, recorder, game, BOARD_10X20);
+      game.reset(456);                              // Tras reiniciar, la grabación empieza de nuevo
+      recorder.restart(456);
+      playRandom(game, recorder, rng, 5000);
+      checkReplay(path, recorder, game, BOARD_10X20);
+   }
+   {
+      const uint64_t seed = 0x9E3779B97F4A7C15ull;  // Usa los 64 bits
+      GameState game(seed);
+      ReplayRecorder recorder(seed);
+      playRandom(game, recorder, rng, 5000);
+      checkReplay(path, recorder, game, BOARD_10X20);
+   }
+   {
+      // Una repetición de la versión 2 se grabó con los 32 bits bajos de la semilla
+      GameState game(0x7F4A7C15);
+      ReplayRecorder recorder(0x7F4A7C15);
+      playRandom(game, recorder, rng, 5000);
+      CHECK(recorder.save(path, game));
+      MappedFile file(path);
+      CHECK(file.ok());
+      if (file.ok()) {
+         vector<uint8_t> legacy(file.data(), file.data() + file.size());
+         legacy[3] = 2;
+         legacy[8] = 0x12;                         // Bits altos que el generador de entonces ignoraba
+         ReplayResult result = playReplay(legacy.data(), legacy.size());
+         CHECK(result.matches);
+         CHECK_EQ(result.seed, uint64_t(0x7F4A7C15));
+      }
+   }
+   {
+      BasicGameState<WideGeometry> game(9);
+      ReplayRecorder recorder(9, BOARD_20X40);
+      playRandom(game, recorder, rng, 20000);
+      checkReplay(path, recorder, game, BOARD_20X40);
+   }
+   const uint8_t garbage[] = {'T', 'T', 'X', 2};
+   CHECK(playReplay(garbage, sizeof(garbage)).error != nullptr);
+   remove(path);
+}
+
+// --- Tabla de transposición ---
+
+// Las jugadas guardadas vuelven intactas en todo el rango de posiciones de las geometrías permitidas
+void testTranspositionTable() {
+   TranspositionTable table(1);
+   const int xs[] = {-3, 0, 9, MAX_ANCHO_TABLERO - 1}, ys[] = {-3, 0, 19, MAX_ALTO_TABLERO - 1};
+   uint64_t key = 1;
+   for (int type = 0; type < NUM_TETROMINOS; ++type) {
+      for (int rotation = 0; rotation < NUM_ROTACIONES; ++rotation) {
+         for (int x : xs) {
+            for (int y : ys) {
+               TTData stored, loaded;
+               stored.score = -1.5f * type + rotation;
+               stored.depth = int8_t(rotation + 1);
+               stored.hasMove = true;
+               stored.move = makePiece(static_cast<Tetromino>(type), rotation, x, y);
+               key = key * 6364136223846793005ULL + 1442695040888963407ULL;
+               table.store(key, stored);
+               CHECK(table.probe(key, loaded));
+               CHECK(loaded.hasMove);
+               CHECK_EQ(loaded.score, stored.score);
+               CHECK_EQ(int(loaded.depth), int(stored.depth));
+               CHECK_EQ(int(loaded.move.type), type);
+               CHECK_EQ(loaded.move.rotation, rotation);
+               CHECK_EQ(loaded.move.x, x);
+               CHECK_EQ(loaded.move.y, y);
+            }
+         }
+      }
+   }
+}
+
+// --- perft ---
+
+uint64_t perftCount(vector<Tetromino> sequence) {
+   MoveGenerator generator;
+   vector<vector<Placement>> buffers(sequence.size() + 1);
+   return perft(Board(), sequence.data(), int(sequence.size()), generator, buffers);
+}
+
+void testPerft() {
+   // Colocaciones distintas de cada pieza en el tablero vacío
+   const uint64_t single[NUM_TETROMINOS] = {17, 9, 34, 34, 34, 17, 17};
+   for (int type = 0; type < NUM_TETROMINOS; ++type) {
+      CHECK_EQ(perftCount({static_cast<Tetromino>(type)}), single[type]);
+   }
+   // Secuencias fijas (no dependen del generador de números al azar de la biblioteca estándar)
+   CHECK_EQ(perftCount({T, I}), uint64_t(598));
+   CHECK_EQ(perftCount({I, O, T}), uint64_t(5265));
+   CHECK_EQ(perftCount({S, Z, L, J}), uint64_t(386409));
+}
+
+int main() {
+   testSrsKicks();
+   testBounds<StandardGeometry>();
+   testBounds<Geometry<30, 20>>();
+   testBounds<Geometry<MAX_ANCHO_TABLERO, 24>>();
+   testIncrementalMetrics<StandardGeometry>(40);
+   testIncrementalMetrics<TallGeometry>(10);
+   testIncrementalMetrics<WideGeometry>(10);
+   testKeyDecoder();
+   testSeeds();
+   testReplayRoundTrip();
+   testTranspositionTable();
+   testPerft();
+   cout << totalChecks - fallos << "/" << totalChecks << " verificaciones correctas\n";
+   return fallos ? 1 : 0;
+}
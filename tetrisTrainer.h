@@ -0,0 +1,234 @@
+// Entrenador genético de los pesos de la evaluación del tablero.
+// Cada individuo es un juego de pesos; su aptitud es el total de líneas que elimina un
+// jugador voraz (una pieza, sin vista previa) en un conjunto fijo de partidas sin
+// interfaz con tope de piezas. Todas las partidas de una generación usan las mismas
+// semillas, derivadas de la semilla del entrenamiento y del número de generación, y
+// también el azar de la selección y la mutación: un entrenamiento reanudado desde un
+// punto de control sigue exactamente igual que si no se hubiera detenido.
+#ifndef TETRIS_TRAINER_H
+#define TETRIS_TRAINER_H
+
+#include <vector>       // Población y resultados
+#include <array>        // Pesos como vector
+#include <random>       // Selección y mutación
+#include <cmath>        // sqrt()
+#include <cstdio>       // Puntos de control
+#include <string>       // Rutas de archivo
+#include <algorithm>    // sort(), max()
+
+#include "tetrisCore.h"  // Partidas
+#include "tetrisMoves.h" // Generador de colocaciones
+#include "tetrisBot.h"   // Pesos, evaluación y pool de hilos
+
+const int NUM_PESOS = 5;     // Altura, líneas, huecos, rugosidad y pozos
+
+using WeightVector = std::array<double, NUM_PESOS>;
+
+inline WeightVector toVector(const EvalWeights &w) { return {w.height, w.lines, w.holes, w.bumpiness, w.wells}; }
+
+inline EvalWeights fromVector(const WeightVector &v) {
+   EvalWeights w;
+   w.height = v[0];
+   w.lines = v[1];
+   w.holes = v[2];
+   w.bumpiness = v[3];
+   w.wells = v[4];
+   return w;
+}
+
+inline void normalize(WeightVector &v) {   // La evaluación solo compara tableros: basta la dirección del vector
+   double norm = 0;
+   for (double x : v) {
+      norm += x * x;
+   }
+   norm = std::sqrt(norm);
+   for (double &x : v) {
+      x = norm > 0 ? x / norm : 1.0 / std::sqrt(double(NUM_PESOS));
+   }
+}
+
+inline uint64_t mixSeed(uint64_t a, uint64_t b) {   // Deriva semillas independientes (splitmix64)
+   uint64_t z = a + 0x9E3779B97F4A7C15ull * (b + 1);
+   z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+   z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+   return z ^ (z >> 31);
+}
+
+// Juega una partida sin interfaz con las reglas del núcleo: en cada pieza elige la colocación
+// alcanzable con mejor evaluación y la fija (el bot coloca dentro de un tick, así que la
+// gravedad nunca interviene). Retorna las líneas eliminadas.
+inline int simulateGame(const EvalWeights &weights, uint64_t seed, int maxPieces, MoveGenerator &generator, std::vector<Placement> &placements) {
+   GameState game(seed);
+   while (!game.gameOver && game.piecesPlaced < uint64_t(maxPieces)) {
+      generator.generate(game.board, game.activePiece.type, placements);
+      if (placements.empty()) {
+         break;
+      }
+      size_t best = 0;
+      double bestScore = -1e18;
+      for (size_t k = 0; k < placements.size(); ++k) {
+         Board next = game.board;
+         next.placePiece(placements[k].piece);
+         int cleared = next.clearFullLines();
+         double score = evaluateBoard(next, cleared, weights);
+         if (score > bestScore) {
+            bestScore = score;
+            best = k;
+         }
+      }
+      game.activePiece = placements[best].piece;
+      game.lockPiece();     // Puntaje, nivel y velocidad como en la partida real
+   }
+   return game.linesCleared;
+}
+
+// Parámetros del entrenamiento (se guardan en el punto de control)
+struct TrainerConfig {
+   int population = 100;          // Individuos por generación
+   int games = 8;                 // Partidas por individuo y generación
+   int maxPieces = 500;           // Tope de piezas por partida
+   uint64_t seed = 1;             // Semilla de todo el entrenamiento
+   double offspring = 0.3;        // Fracción de la población que se reemplaza en cada generación
+   double tournament = 0.1;       // Fracción de la población que compite en cada torneo
+   double mutationRate = 0.05;    // Probabilidad de mutar un hijo
+   double mutationStep = 0.2;     // Amplitud máxima de la mutación de un peso
+};
+
+struct Individual {
+   WeightVector weights{};
+   double fitness = 0;            // Líneas medias por partida en la última generación
+};
+
+class WeightTrainer {
+public:
+   WeightTrainer(ThreadPool &pool, const TrainerConfig &config) : pool(pool), config(config) {}
+
+   void initialize() {   // Población inicial al azar
+      std::mt19937_64 rng(mixSeed(config.seed, ~0ull));
+      std::uniform_real_distribution<double> uniform(-1, 1);
+      population.assign(std::max(2, config.population), Individual());
+      for (Individual &individual : population) {
+         for (double &w : individual.weights) {
+            w = uniform(rng);
+         }
+         normalize(individual.weights);
+      }
+      generation = 0;
+   }
+
+   // Juega las partidas de la generación actual en paralelo y ordena la población por aptitud
+   void evaluate() {
+      int games = std::max(1, config.games);
+      lines.assign(population.size() * games, 0);
+      pool.parallelFor(lines.size(), [&](int task) {
+         thread_local MoveGenerator generator;
+         thread_local std::vector<Placement> placements;
+         const Individual &individual = population[task / games];
+         lines[task] = simulateGame(fromVector(individual.weights), mixSeed(config.seed, uint64_t(generation) * games + task % games),
+                                    config.maxPieces, generator, placements);
+      });
+      for (size_t i = 0; i < population.size(); ++i) {
+         double sum = 0;
+         for (int g = 0; g < games; ++g) {
+            sum += lines[i * games + g];
+         }
+         population[i].fitness = sum / games;
+      }
+      std::stable_sort(population.begin(), population.end(), [](const Individual &a, const Individual &b) { return a.fitness > b.fitness; });
+      gamesPlayed += lines.size();
+   }
+
+   // Reemplaza a los peores por hijos de torneos (promedio ponderado por aptitud y mutación ocasional)
+   void evolve() {
+      std::mt19937_64 rng(mixSeed(config.seed, uint64_t(generation) | 1ull << 63));
+      std::uniform_real_distribution<double> uniform(0, 1);
+      int size = population.size();
+      int children = std::min(size - 1, std::max(1, int(size * config.offspring)));
+      int entrants = std::max(2, int(size * config.tournament));
+      std::vector<Individual> born;
+      for (int c = 0; c < children; ++c) {
+         int first = -1, second = -1;     // Los dos mejores del torneo (la población ya está ordenada)
+         for (int k = 0; k < entrants; ++k) {
+            int pick = rng() % size;
+            if (first < 0 || pick < first) {
+               second = first;
+               first = pick;
+            } else if (pick != first && (second < 0 || pick < second)) {
+               second = pick;
+            }
+         }
+         second = second < 0 ? (first + 1) % size : second;
+         const Individual &a = population[first], &b = population[second];
+         double total = a.fitness + b.fitness;
+         double share = total > 0 ? a.fitness / total : 0.5;
+         Individual child;
+         for (int w = 0; w < NUM_PESOS; ++w) {
+            child.weights[w] = a.weights[w] * share + b.weights[w] * (1 - share);
+         }
+         if (uniform(rng) < config.mutationRate) {
+            child.weights[rng() % NUM_PESOS] += (uniform(rng) * 2 - 1) * config.mutationStep;
+         }
+         normalize(child.weights);
+         born.push_back(child);
+      }
+      std::copy(born.begin(), born.end(), population.end() - children);
+      generation++;
+   }
+
+   // Punto de control en texto: parámetros, generación y población. Se escribe en un
+   // archivo temporal y se renombra para no dejar uno a medias si el proceso muere.
+   bool save(const std::string &path) const {
+      std::string temporary = path + ".tmp";
+      FILE *file = std::fopen(temporary.c_str(), "w");
+      if (!file) {
+         return false;
+      }
+      std::fprintf(file, "TTRAIN 1\n%d %d %d %d %llu %llu\n", generation, int(population.size()), config.games, config.maxPieces,
+                   (unsigned long long)config.seed, (unsigned long long)gamesPlayed);
+      for (const Individual &individual : population) {
+         for (double w : individual.weights) {
+            std::fprintf(file, "%.17g ", w);
+         }
+         std::fprintf(file, "%.17g\n", individual.fitness);
+      }
+      bool ok = std::fclose(file) == 0;
+      return ok && std::rename(temporary.c_str(), path.c_str()) == 0;
+   }
+
+   bool load(const std::string &path) {   // Retorna falso si el archivo no existe o no es un punto de control
+      FILE *file = std::fopen(path.c_str(), "r");
+      if (!file) {
+         return false;
+      }
+      int version = 0, size = 0;
+      unsigned long long seed = 0, played = 0;
+      bool ok = std::fscanf(file, "TTRAIN %d %d %d %d %d %llu %llu", &version, &generation, &size, &config.games, &config.maxPieces, &seed, &played) == 7
+                && version == 1 && size >= 2;
+      population.assign(ok ? size : 0, Individual());
+      for (Individual &individual : population) {
+         for (double &w : individual.weights) {
+            ok = ok && std::fscanf(file, "%lf", &w) == 1;
+         }
+         ok = ok && std::fscanf(file, "%lf", &individual.fitness) == 1;
+      }
+      std::fclose(file);
+      config.seed = seed;
+      config.population = size;
+      gamesPlayed = played;
+      return ok;
+   }
+
+   const Individual &best() const { return population.front(); }   // Mejor individuo de la última evaluación
+   const TrainerConfig &settings() const { return config; }
+
+   int generation = 0;
+   uint64_t gamesPlayed = 0;      // Partidas jugadas en todo el entrenamiento (incluye ejecuciones anteriores)
+
+private:
+   ThreadPool &pool;
+   TrainerConfig config;
+   std::vector<Individual> population;
+   std::vector<int> lines;        // Líneas de cada partida de la generación (individuo * partidas + partida)
+};
+
+#endif